@@ -0,0 +1,600 @@
+/*
+   Host harness: stand-ins for the Pebble SDK & karambola calls src/c makes, and the frame driver.
+
+   The app's own main( ) runs: app_event_loop( ) below alternates the world update timer and the world layer's update proc until
+   BENCHMARK logs "benchmark:: done". BENCHMARK times each frame itself (update + draw, on host_ns( ) through HOST, without its
+   framebuffer fingerprint or host_fb_clear( )) and logs its per case ns/frame. The harness then reports:
+     - ns/frame percentiles over the whole run, from those same BENCHMARK frame times,
+     - a fingerprint of the draw calls made: every primitive with its points, stroke color, ink & antialiasing,
+       in order. It does not depend on how the primitives are rasterized.
+   The GContext primitives rasterize into an in-memory framebuffer (8 bit, 8 bit circular or 1 bit, per platform), which
+   BENCHMARK fingerprints itself through graphics_capture_frame_buffer( ). That raster is a model: lines are non antialiased
+   Bresenham and Draw2D_line_pattern( ) an ordered dither, as the firmware & karambola rasterizers are not available here.
+   Pixel fingerprints compare builds of this tree with each other, not with a watch.
+
+   Q math follows karambola's 16.16 API with exact 64 bit products/quotients and an exact integer square root; sin/cos
+   are rounded libm values. Timings are the host's, only meaningful relative to each other.
+*/
+
+#include <pebble.h>
+#include <karambola/Q2.h>
+#include <karambola/Q3.h>
+#include <karambola/CamQ3.h>
+#include <karambola/Sampler.h>
+#include <karambola/Draw2D.h>
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "Config.h"
+
+
+/* -----------   karambola: Q   ----------- */
+
+Q
+Q_mul( Q a, Q b )
+{ return (Q)(((int64_t)a * b) >> 16) ; }
+
+
+Q
+Q_div( Q a, Q b )
+{
+  if (b == 0)
+    return (a >= 0) ? INT32_MAX : INT32_MIN ;
+
+  return (Q)(((int64_t)a << 16) / b) ;
+}
+
+
+Q
+Q_sqrt( Q a )
+{
+  if (a <= 0)
+    return Q_0 ;
+
+  const uint64_t  v = (uint64_t)a << 16 ;
+  uint64_t        r = (uint64_t)sqrt( (double)v ) ;
+
+  while (r * r > v)              --r ;
+  while ((r + 1) * (r + 1) <= v)  ++r ;
+
+  return (Q)r ;
+}
+
+
+/* -----------   karambola: Q2, Q3   ----------- */
+
+const Q2 Q2_origin = { Q_0, Q_0 } ;
+
+Q2 *Q2_set( Q2 *r, Q x, Q y )                          { r->x = x ;  r->y = y ;  return r ; }
+Q2 *Q2_add( Q2 *r, const Q2 *a, const Q2 *b )          { return Q2_set( r, a->x + b->x, a->y + b->y ) ; }
+Q2 *Q2_sub( Q2 *r, const Q2 *a, const Q2 *b )          { return Q2_set( r, a->x - b->x, a->y - b->y ) ; }
+Q2 *Q2_sca( Q2 *r, Q k, const Q2 *v )                  { return Q2_set( r, Q_mul( k, v->x ), Q_mul( k, v->y ) ) ; }
+
+Q3 *Q3_set( Q3 *r, Q x, Q y, Q z )                     { r->x = x ;  r->y = y ;  r->z = z ;  return r ; }
+Q3 *Q3_add( Q3 *r, const Q3 *a, const Q3 *b )          { return Q3_set( r, a->x + b->x, a->y + b->y, a->z + b->z ) ; }
+Q3 *Q3_sub( Q3 *r, const Q3 *a, const Q3 *b )          { return Q3_set( r, a->x - b->x, a->y - b->y, a->z - b->z ) ; }
+Q3 *Q3_sca( Q3 *r, Q k, const Q3 *v )                  { return Q3_set( r, Q_mul( k, v->x ), Q_mul( k, v->y ), Q_mul( k, v->z ) ) ; }
+Q   Q3_dot( const Q3 *a, const Q3 *b )                 { return Q_mul( a->x, b->x ) + Q_mul( a->y, b->y ) + Q_mul( a->z, b->z ) ; }
+Q3 *Q3_scaTo( Q3 *r, Q length, const Q3 *v )           { return Q3_sca( r, Q_div( length, Q_sqrt( Q3_dot( v, v ) ) ), v ) ; }
+
+
+Q3 *
+Q3_rotZ( Q3 *r, const Q3 *v, int32_t angle )
+{
+  const Q  c = cos_lookup( angle ), s = sin_lookup( angle ) ;
+
+  return Q3_set( r, Q_mul( c, v->x ) - Q_mul( s, v->y ), Q_mul( s, v->x ) + Q_mul( c, v->y ), v->z ) ;
+}
+
+
+Q3 *
+Q3_rotX( Q3 *r, const Q3 *v, int32_t angle )
+{
+  const Q  c = cos_lookup( angle ), s = sin_lookup( angle ) ;
+
+  return Q3_set( r, v->x, Q_mul( c, v->y ) - Q_mul( s, v->z ), Q_mul( s, v->y ) + Q_mul( c, v->z ) ) ;
+}
+
+
+static
+Q3 *
+Q3_cross( Q3 *r, const Q3 *a, const Q3 *b )
+{ return Q3_set( r, Q_mul( a->y, b->z ) - Q_mul( a->z, b->y ), Q_mul( a->z, b->x ) - Q_mul( a->x, b->z ), Q_mul( a->x, b->y ) - Q_mul( a->y, b->x ) ) ; }
+
+
+/* -----------   karambola: CamQ3   ----------- */
+
+void
+CamQ3_lookAtOriginUpwards( CamQ3 *cam, const Q3 *viewPoint, Q zoom, CamProjection projection )
+{
+  const Q3  toOrigin = { -viewPoint->x, -viewPoint->y, -viewPoint->z } ;
+  const Q3  up       = { Q_0, Q_0, Q_1 } ;
+  Q3        xAxis ;
+
+  cam->viewPoint  = *viewPoint ;
+  cam->zoom       = zoom ;
+  cam->projection = projection ;
+
+  Q3_scaTo( &cam->zAxis, Q_1, &toOrigin ) ;
+  Q3_scaTo( &cam->xAxis, Q_1, Q3_cross( &xAxis, &cam->zAxis, &up ) ) ;
+  Q3_cross( &cam->yAxis, &cam->xAxis, &cam->zAxis ) ;
+}
+
+
+Q2 *
+CamQ3_view( Q2 *film, const CamQ3 *cam, const Q3 *world )
+{
+  Q3  d ;
+
+  Q3_sub( &d, world, &cam->viewPoint ) ;
+
+  const Q  k = (cam->projection == CAM_PROJECTION_PERSPECTIVE) ? Q_div( cam->zoom, Q3_dot( &d, &cam->zAxis ) ) : cam->zoom ;
+
+  return Q2_set( film, Q_mul( k, Q3_dot( &d, &cam->xAxis ) ), Q_mul( k, Q3_dot( &d, &cam->yAxis ) ) ) ;
+}
+
+
+/* -----------   karambola: Sampler   ----------- */
+
+Sampler *
+Sampler_new( uint16_t capacity )
+{
+  Sampler *sampler = calloc( 1, sizeof(Sampler) + capacity * sizeof(int16_t) ) ;
+
+  sampler->capacity = capacity ;
+  return sampler ;
+}
+
+
+void
+Sampler_free( Sampler *sampler )
+{ free( sampler ) ; }
+
+
+void
+Sampler_push( Sampler *sampler, int16_t sample )
+{
+  if (sampler->samplesNum < sampler->capacity)
+    sampler->samples[sampler->samplesNum++] = sample ;
+  else
+  {
+    sampler->samplesAcum -= sampler->samples[sampler->oldestIdx] ;
+    sampler->samples[sampler->oldestIdx] = sample ;
+    sampler->oldestIdx = (sampler->oldestIdx + 1) % sampler->capacity ;
+  }
+
+  sampler->samplesAcum += sample ;
+}
+
+
+/* -----------   Trigonometry, time & log   ----------- */
+
+int32_t sin_lookup( int32_t angle )   { return (int32_t)lround( sin( (angle & 0xFFFF) * (2 * M_PI / TRIG_MAX_ANGLE) ) * TRIG_MAX_RATIO ) ; }
+int32_t cos_lookup( int32_t angle )   { return (int32_t)lround( cos( (angle & 0xFFFF) * (2 * M_PI / TRIG_MAX_ANGLE) ) * TRIG_MAX_RATIO ) ; }
+
+
+uint64_t
+host_ns
+( void )
+{
+  struct timespec  ts ;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts ) ;
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec ;
+}
+
+
+uint16_t
+time_ms( time_t *tloc, uint16_t *out_ms )
+{
+  const uint64_t  ns = host_ns( ) ;
+  const uint16_t  ms = (ns / 1000000u) % 1000u ;
+
+  if (tloc   != NULL)  *tloc   = (time_t)(ns / 1000000000u) ;
+  if (out_ms != NULL)  *out_ms = ms ;
+
+  return ms ;
+}
+
+
+static bool  host_isDone = false ;   // BENCHMARK went through every case.
+
+
+void
+app_log( uint8_t level, const char *filename, int line, const char *fmt, ... )
+{
+  char     message[256] ;
+  va_list  args ;
+
+  va_start( args, fmt ) ;
+  vsnprintf( message, sizeof(message), fmt, args ) ;
+  va_end( args ) ;
+
+  printf( "%s\n", message ) ;
+
+  if (strncmp( message, "benchmark:: done", 16 ) == 0)
+    host_isDone = true ;
+}
+
+
+/* -----------   Framebuffer   ----------- */
+
+#if defined(PBL_COLOR)
+  #define HOST_FB_BYTES_PER_ROW   PBL_DISPLAY_WIDTH
+#else
+  #define HOST_FB_BYTES_PER_ROW   (((PBL_DISPLAY_WIDTH + 31) / 32) * 4)     //  1 bit, rows padded to 32 bits.
+#endif
+
+struct GBitmap
+{
+  uint8_t  data[PBL_DISPLAY_HEIGHT][HOST_FB_BYTES_PER_ROW] ;
+  int16_t  minX[PBL_DISPLAY_HEIGHT] ;      //  Pixels the display has on each row: all of them unless PBL_ROUND.
+  int16_t  maxX[PBL_DISPLAY_HEIGHT] ;
+} ;
+
+static GBitmap  host_fb ;
+
+
+static
+void
+host_fb_initialize
+( void )
+{
+  for (int y = 0  ;  y < PBL_DISPLAY_HEIGHT  ;  ++y)
+  {
+    #if defined(PBL_ROUND)
+      const double  r  = PBL_DISPLAY_WIDTH / 2.0 ;
+      const double  dy = y + 0.5 - PBL_DISPLAY_HEIGHT / 2.0 ;
+      const int     dx = (dy * dy < r * r) ? (int)(sqrt( r * r - dy * dy ) + 0.5) : 0 ;
+
+      host_fb.minX[y] = PBL_DISPLAY_WIDTH / 2 - dx ;
+      host_fb.maxX[y] = PBL_DISPLAY_WIDTH / 2 + dx - 1 ;
+    #else
+      host_fb.minX[y] = 0 ;
+      host_fb.maxX[y] = PBL_DISPLAY_WIDTH - 1 ;
+    #endif
+  }
+}
+
+
+static
+void
+host_fb_set
+( int x, int y, GColor color )
+{
+  if (y < 0  ||  y >= PBL_DISPLAY_HEIGHT  ||  x < host_fb.minX[y]  ||  x > host_fb.maxX[y]  ||  color.argb >> 6 == 0)
+    return ;
+
+  #if defined(PBL_COLOR)
+    host_fb.data[y][x] = color.argb ;
+  #else
+    if (gcolor_equal( color, GColorWhite ))
+      host_fb.data[y][x >> 3] |=  (1 << (x & 7)) ;
+    else
+      host_fb.data[y][x >> 3] &= ~(1 << (x & 7)) ;
+  #endif
+}
+
+
+static
+void
+host_fb_clear
+( GColor color )
+{
+  for (int y = 0  ;  y < PBL_DISPLAY_HEIGHT  ;  ++y)
+    for (int x = 0  ;  x < PBL_DISPLAY_WIDTH  ;  ++x)
+      host_fb_set( x, y, color ) ;
+}
+
+
+GBitmap *graphics_capture_frame_buffer( GContext *ctx )                { return &host_fb ; }
+bool     graphics_release_frame_buffer( GContext *ctx, GBitmap *fb )   { return true ; }
+GRect    gbitmap_get_bounds( const GBitmap *bitmap )                   { return (GRect){ { 0, 0 }, { PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT } } ; }
+uint8_t *gbitmap_get_data( const GBitmap *bitmap )                     { return (uint8_t *)bitmap->data ; }
+uint16_t gbitmap_get_bytes_per_row( const GBitmap *bitmap )            { return HOST_FB_BYTES_PER_ROW ; }
+
+
+GBitmapFormat
+gbitmap_get_format( const GBitmap *bitmap )
+{
+  #if defined(PBL_ROUND)
+    return GBitmapFormat8BitCircular ;
+  #elif defined(PBL_COLOR)
+    return GBitmapFormat8Bit ;
+  #else
+    return GBitmapFormat1Bit ;
+  #endif
+}
+
+
+GBitmapDataRowInfo
+gbitmap_get_data_row_info( const GBitmap *bitmap, uint16_t y )
+{ return (GBitmapDataRowInfo){ .data = (uint8_t *)bitmap->data[y], .min_x = bitmap->minX[y], .max_x = bitmap->maxX[y] } ; }
+
+
+/* -----------   GContext model & draw call fingerprint   ----------- */
+
+static GColor    host_stroke ;
+static bool      host_isAntialiased = false ;
+static uint64_t  host_callHash      = 1469598103934665603u ;   //  FNV-1a
+static uint64_t  host_pixelCalls    = 0 ;
+static uint64_t  host_lineCalls     = 0 ;
+static uint64_t  host_patternCalls  = 0 ;
+static uint64_t  host_pathCalls     = 0 ;
+
+
+static
+void
+host_call_hash
+( int32_t value )
+{
+  for (int b = 0  ;  b < 4  ;  ++b)
+  {
+    host_callHash ^= (uint8_t)(value >> (8 * b)) ;
+    host_callHash *= 1099511628211u ;
+  }
+}
+
+
+// Non antialiased Bresenham, both ends drawn, ink pattern applied in screen space.
+static
+void
+host_line
+( int x0, int y0, const int x1, const int y1, const ink_t ink )
+{
+  const int  dx = abs( x1 - x0 ), sx = (x0 < x1) ? 1 : -1 ;
+  const int  dy = -abs( y1 - y0 ), sy = (y0 < y1) ? 1 : -1 ;
+  int        err = dx + dy ;
+
+  for ( ; ; )
+  {
+    bool  isInked = true ;
+
+    switch (ink)
+    {
+      case INK0:    isInked = false ;                      break ;
+      case INK25:   isInked = ((x0 | y0) & 1) == 0 ;       break ;
+      case INK33:   isInked = (x0 + y0) % 3 == 0 ;         break ;
+      case INK50:   isInked = ((x0 ^ y0) & 1) == 0 ;       break ;
+      case INK66:   isInked = (x0 + y0) % 3 != 0 ;         break ;
+      case INK75:   isInked = ((x0 & y0) & 1) == 0 ;       break ;
+      case INK100:  isInked = true ;                       break ;
+    }
+
+    if (isInked)
+      host_fb_set( x0, y0, host_stroke ) ;
+
+    if (x0 == x1  &&  y0 == y1)
+      break ;
+
+    const int  err2 = 2 * err ;
+
+    if (err2 >= dy)  { err += dy ;  x0 += sx ; }
+    if (err2 <= dx)  { err += dx ;  y0 += sy ; }
+  }
+}
+
+
+void graphics_context_set_stroke_color( GContext *ctx, GColor color )   { host_stroke = color ; }
+void graphics_context_set_stroke_width( GContext *ctx, uint8_t width )  { }
+void graphics_context_set_antialiased( GContext *ctx, bool enable )     { host_isAntialiased = enable ; }
+
+
+void
+graphics_draw_pixel( GContext *ctx, GPoint point )
+{
+  ++host_pixelCalls ;
+  host_call_hash( 1 ) ;  host_call_hash( point.x ) ;  host_call_hash( point.y ) ;  host_call_hash( host_stroke.argb ) ;
+
+  host_fb_set( point.x, point.y, host_stroke ) ;
+}
+
+
+void
+graphics_draw_line( GContext *ctx, GPoint p0, GPoint p1 )
+{
+  ++host_lineCalls ;
+  host_call_hash( 2 ) ;  host_call_hash( p0.x ) ;  host_call_hash( p0.y ) ;  host_call_hash( p1.x ) ;  host_call_hash( p1.y ) ;
+  host_call_hash( host_stroke.argb ) ;  host_call_hash( host_isAntialiased ) ;
+
+  host_line( p0.x, p0.y, p1.x, p1.y, INK100 ) ;
+}
+
+
+void
+gpath_draw_outline_open( GContext *ctx, GPath *path )
+{
+  ++host_pathCalls ;
+  host_call_hash( 3 ) ;  host_call_hash( path->num_points ) ;
+
+  for (uint32_t p = 0  ;  p < path->num_points  ;  ++p)
+  {
+    host_call_hash( path->points[p].x ) ;  host_call_hash( path->points[p].y ) ;
+  }
+
+  host_call_hash( host_stroke.argb ) ;  host_call_hash( host_isAntialiased ) ;
+
+  for (uint32_t p = 1  ;  p < path->num_points  ;  ++p)
+    host_line( path->points[p-1].x, path->points[p-1].y, path->points[p].x, path->points[p].y, INK100 ) ;
+}
+
+
+void
+Draw2D_line_pattern( GContext *gCtx, int x0, int y0, int x1, int y1, ink_t ink )
+{
+  ++host_patternCalls ;
+  host_call_hash( 4 ) ;  host_call_hash( x0 ) ;  host_call_hash( y0 ) ;  host_call_hash( x1 ) ;  host_call_hash( y1 ) ;
+  host_call_hash( ink ) ;  host_call_hash( host_stroke.argb ) ;
+
+  host_line( x0, y0, x1, y1, ink ) ;
+}
+
+
+/* -----------   Services   ----------- */
+
+int  accel_service_peek( AccelData *data )                                            { return -1 ; }   //  BENCHMARK scripts its own.
+void accel_data_service_subscribe( uint32_t samples_per_update, AccelDataHandler h )  { }
+void accel_data_service_unsubscribe( void )                                           { }
+void tick_timer_service_subscribe( TimeUnits tick_units, TickHandler handler )        { }
+void tick_timer_service_unsubscribe( void )                                           { }
+
+struct AppTimer { AppTimerCallback  callback ;  void *data ; } ;
+
+static AppTimer  host_timer ;
+
+
+AppTimer *
+app_timer_register( uint32_t timeout_ms, AppTimerCallback callback, void *callback_data )
+{
+  host_timer = (AppTimer){ .callback = callback, .data = callback_data } ;
+  return &host_timer ;
+}
+
+
+void
+app_timer_cancel( AppTimer *timer )
+{ timer->callback = NULL ; }
+
+
+/* -----------   Windows & layers   ----------- */
+
+struct Layer  { GRect frame ;  LayerUpdateProc update ;  bool isDirty ; } ;
+struct Window { Layer root ;  GColor background ;  WindowHandlers handlers ; } ;
+
+static Window   host_window ;
+static Layer    host_layer ;              //  The app creates a single layer: the world.
+static GContext *host_ctx = NULL ;        //  Never dereferenced.
+
+
+Layer *
+layer_create( GRect frame )
+{
+  host_layer = (Layer){ .frame = frame } ;
+  return &host_layer ;
+}
+
+
+void   layer_destroy( Layer *layer )                                 { }
+void   layer_mark_dirty( Layer *layer )                              { layer->isDirty = true ; }
+void   layer_set_update_proc( Layer *layer, LayerUpdateProc proc )   { layer->update = proc ; }
+void   layer_add_child( Layer *parent, Layer *child )                { }
+GRect  layer_get_frame( const Layer *layer )                         { return layer->frame ; }
+GRect  layer_get_unobstructed_bounds( const Layer *layer )           { return (GRect){ { 0, 0 }, layer->frame.size } ; }
+
+
+Window *
+window_create( void )
+{
+  host_window = (Window){ .root = { .frame = { { 0, 0 }, { PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT } } } } ;
+  return &host_window ;
+}
+
+
+void    window_destroy( Window *window )                                  { }
+Layer  *window_get_root_layer( const Window *window )                     { return (Layer *)&window->root ; }
+void    window_set_background_color( Window *window, GColor color )       { window->background = color ; }
+void    window_set_window_handlers( Window *window, WindowHandlers h )    { window->handlers = h ; }
+Window *window_stack_remove( Window *window, bool animated )               { return window ; }
+void    window_stack_pop_all( bool animated )                             { host_isDone = true ; }
+void    window_single_click_subscribe( ButtonId id, ClickHandler h )      { }
+void    window_long_click_subscribe( ButtonId id, uint16_t delay_ms, ClickHandler down, ClickHandler up ) { }
+
+
+void
+window_stack_push( Window *window, bool animated )
+{
+  if (window->handlers.load != NULL)
+    window->handlers.load( window ) ;
+}
+
+
+ActionBarLayer *action_bar_layer_create( void )                                                       { return (ActionBarLayer *)&host_window ; }
+void            action_bar_layer_set_background_color( ActionBarLayer *bar, GColor color )            { }
+void            action_bar_layer_set_click_config_provider( ActionBarLayer *bar, ClickConfigProvider p ) { }
+void            action_bar_layer_add_to_window( ActionBarLayer *bar, Window *window )                 { }
+
+
+/* -----------   Frame driver   ----------- */
+
+#define HOST_FRAMES_MAX   (1 << 16)
+
+static uint32_t  host_frameNs[HOST_FRAMES_MAX] ;
+static int       host_frames = 0 ;
+
+
+// BENCHMARK's own frame durations (world_update( ) + world_draw( ), without its framebuffer fingerprint).
+void
+host_frame_record
+( uint32_t ns )
+{
+  if (host_frames < HOST_FRAMES_MAX)
+    host_frameNs[host_frames++] = ns ;
+}
+
+
+static
+int
+host_ns_compare
+( const void *a, const void *b )
+{ return (*(const uint32_t *)a > *(const uint32_t *)b) - (*(const uint32_t *)a < *(const uint32_t *)b) ; }
+
+
+// Sorts frameNs in place.
+static
+void
+host_frames_report
+( const char *label, uint32_t *frameNs, const int frames )
+{
+  uint64_t  total = 0 ;
+
+  for (int f = 0  ;  f < frames  ;  ++f)
+    total += frameNs[f] ;
+
+  qsort( frameNs, frames, sizeof(uint32_t), host_ns_compare ) ;
+
+  printf( "host:: %s %d frames, mean %llu ns/frame, p50 %lu p90 %lu p99 %lu max %lu ns\n"
+        , label, frames, (unsigned long long)(total / frames)
+        , (unsigned long)frameNs[frames * 50 / 100], (unsigned long)frameNs[frames * 90 / 100]
+        , (unsigned long)frameNs[frames * 99 / 100], (unsigned long)frameNs[frames - 1]
+        ) ;
+}
+
+
+void
+app_event_loop( void )
+{
+  host_fb_initialize( ) ;
+
+  // window_load( ) already ran the first world_update( ).
+  while (!host_isDone)
+  {
+    if (host_layer.isDirty  &&  host_layer.update != NULL)
+    {
+      host_layer.isDirty = false ;
+
+      host_fb_clear( host_window.background ) ;
+      host_layer.update( &host_layer, host_ctx ) ;
+    }
+
+    if (host_timer.callback != NULL)
+    {
+      const AppTimerCallback  callback = host_timer.callback ;
+
+      host_timer.callback = NULL ;
+      callback( host_timer.data ) ;
+    }
+    else if (!host_layer.isDirty)
+      break ;
+  }
+
+  if (host_frames > 0)
+    host_frames_report( "all", host_frameNs, host_frames ) ;
+
+  printf( "host:: calls %016llx : %llu pixels, %llu lines, %llu paths, %llu patterns\n"
+        , (unsigned long long)host_callHash
+        , (unsigned long long)host_pixelCalls, (unsigned long long)host_lineCalls
+        , (unsigned long long)host_pathCalls,  (unsigned long long)host_patternCalls
+        ) ;
+}
@@ -0,0 +1,21 @@
+/*
+   Host harness: stand-in for karambola's CamQ3.h. Implemented in host.c.
+*/
+
+#pragma once
+
+#include <karambola/Q2.h>
+#include <karambola/Q3.h>
+
+typedef enum { CAM_PROJECTION_ORTHOGRAPHIC, CAM_PROJECTION_PERSPECTIVE } CamProjection ;
+
+typedef struct CamQ3
+{
+  Q3             viewPoint ;
+  Q3             xAxis, yAxis, zAxis ;
+  Q              zoom ;
+  CamProjection  projection ;
+} CamQ3 ;
+
+void  CamQ3_lookAtOriginUpwards( CamQ3 *cam, const Q3 *viewPoint, Q zoom, CamProjection projection ) ;
+Q2   *CamQ3_view( Q2 *film, const CamQ3 *cam, const Q3 *world ) ;
@@ -0,0 +1,11 @@
+/*
+   Host harness: stand-in for karambola's Draw2D.h. Implemented in host.c.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+typedef enum { INK0, INK25, INK33, INK50, INK66, INK75, INK100 } ink_t ;
+
+void Draw2D_line_pattern( GContext *gCtx, int x0, int y0, int x1, int y1, ink_t ink ) ;
@@ -0,0 +1,20 @@
+/*
+   Host harness: stand-in for karambola's Q.h (signed 16.16 fixed point). Implemented in host.c.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+typedef int32_t Q ;
+
+#define Q_0                  ((Q)0)
+#define Q_1                  ((Q)0x10000)
+#define Q_EPSILON            ((Q)1)
+#define Q_from_int( i )      ((Q)((i) << 16))
+#define Q_from_float( f )    ((Q)((f) * 65536.0f))
+#define Q_to_int( q )        ((int32_t)((q) >> 16))
+
+Q Q_mul( Q a, Q b ) ;
+Q Q_div( Q a, Q b ) ;
+Q Q_sqrt( Q a ) ;
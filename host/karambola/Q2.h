@@ -0,0 +1,16 @@
+/*
+   Host harness: stand-in for karambola's Q2.h. Implemented in host.c.
+*/
+
+#pragma once
+
+#include <karambola/Q.h>
+
+typedef struct Q2 { Q x, y ; } Q2 ;
+
+extern const Q2 Q2_origin ;
+
+Q2 *Q2_set( Q2 *r, Q x, Q y ) ;
+Q2 *Q2_add( Q2 *r, const Q2 *a, const Q2 *b ) ;
+Q2 *Q2_sub( Q2 *r, const Q2 *a, const Q2 *b ) ;
+Q2 *Q2_sca( Q2 *r, Q k, const Q2 *v ) ;
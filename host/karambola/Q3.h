@@ -0,0 +1,18 @@
+/*
+   Host harness: stand-in for karambola's Q3.h. Implemented in host.c.
+*/
+
+#pragma once
+
+#include <karambola/Q.h>
+
+typedef struct Q3 { Q x, y, z ; } Q3 ;
+
+Q3 *Q3_set( Q3 *r, Q x, Q y, Q z ) ;
+Q3 *Q3_add( Q3 *r, const Q3 *a, const Q3 *b ) ;
+Q3 *Q3_sub( Q3 *r, const Q3 *a, const Q3 *b ) ;
+Q3 *Q3_sca( Q3 *r, Q k, const Q3 *v ) ;
+Q3 *Q3_scaTo( Q3 *r, Q length, const Q3 *v ) ;
+Q3 *Q3_rotZ( Q3 *r, const Q3 *v, int32_t angle ) ;
+Q3 *Q3_rotX( Q3 *r, const Q3 *v, int32_t angle ) ;
+Q   Q3_dot( const Q3 *a, const Q3 *b ) ;
@@ -0,0 +1,20 @@
+/*
+   Host harness: stand-in for karambola's Sampler.h (running sum over the last capacity samples). Implemented in host.c.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+typedef struct Sampler
+{
+  uint16_t  capacity ;
+  uint16_t  samplesNum ;
+  int32_t   samplesAcum ;
+  uint16_t  oldestIdx ;
+  int16_t   samples[] ;
+} Sampler ;
+
+Sampler *Sampler_new( uint16_t capacity ) ;
+void     Sampler_free( Sampler *sampler ) ;
+void     Sampler_push( Sampler *sampler, int16_t sample ) ;
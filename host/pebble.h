@@ -0,0 +1,168 @@
+/*
+   Host harness: stand-in for the parts of the Pebble SDK pebble.h that src/c uses.
+   Implemented in host.c. Platform (PBL_COLOR/PBL_BW, PBL_RECT/PBL_ROUND, PBL_DISPLAY_*) comes from run.sh.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* -----------   Graphics types   ----------- */
+
+typedef union GColor8 { uint8_t argb ; } GColor8 ;
+typedef GColor8 GColor ;
+
+#define GColorClear            ((GColor8){ .argb = 0x00 })
+#define GColorBlack            ((GColor8){ .argb = 0xC0 })
+#define GColorBlue             ((GColor8){ .argb = 0xC3 })
+#define GColorGreen            ((GColor8){ .argb = 0xCC })
+#define GColorVividCerulean    ((GColor8){ .argb = 0xCB })
+#define GColorCyan             ((GColor8){ .argb = 0xCF })
+#define GColorRed              ((GColor8){ .argb = 0xF0 })
+#define GColorMagenta          ((GColor8){ .argb = 0xF3 })
+#define GColorOrange           ((GColor8){ .argb = 0xF8 })
+#define GColorYellow           ((GColor8){ .argb = 0xFC })
+#define GColorMelon            ((GColor8){ .argb = 0xFE })
+#define GColorDarkGray         ((GColor8){ .argb = 0xD5 })
+#define GColorWhite            ((GColor8){ .argb = 0xFF })
+#define GColorFromHEX( hex )   ((GColor8){ .argb = (uint8_t)(hex) })
+
+typedef struct GPoint { int16_t x, y ; } GPoint ;
+typedef struct GSize  { int16_t w, h ; } GSize ;
+typedef struct GRect  { GPoint origin ; GSize size ; } GRect ;
+
+#define GPoint( x, y )   ((GPoint){ (x), (y) })
+
+typedef struct GPath { uint32_t num_points ; GPoint *points ; int32_t rotation ; GPoint offset ; } GPath ;
+
+typedef enum { GBitmapFormat1Bit, GBitmapFormat8Bit, GBitmapFormat8BitCircular } GBitmapFormat ;
+typedef struct GBitmap GBitmap ;
+typedef struct GBitmapDataRowInfo { uint8_t *data ; int16_t min_x, max_x ; } GBitmapDataRowInfo ;
+
+typedef struct GContext GContext ;
+
+static inline bool gcolor_equal( GColor8 a, GColor8 b )                   { return a.argb == b.argb ; }
+static inline bool gpoint_equal( const GPoint *a, const GPoint *b )       { return a->x == b->x  &&  a->y == b->y ; }
+
+GBitmap            *graphics_capture_frame_buffer( GContext *ctx ) ;
+bool                graphics_release_frame_buffer( GContext *ctx, GBitmap *bitmap ) ;
+GBitmapFormat       gbitmap_get_format( const GBitmap *bitmap ) ;
+GRect               gbitmap_get_bounds( const GBitmap *bitmap ) ;
+uint8_t            *gbitmap_get_data( const GBitmap *bitmap ) ;
+uint16_t            gbitmap_get_bytes_per_row( const GBitmap *bitmap ) ;
+GBitmapDataRowInfo  gbitmap_get_data_row_info( const GBitmap *bitmap, uint16_t y ) ;
+
+void graphics_context_set_stroke_color( GContext *ctx, GColor color ) ;
+void graphics_context_set_stroke_width( GContext *ctx, uint8_t width ) ;
+void graphics_context_set_antialiased( GContext *ctx, bool enable ) ;
+void graphics_draw_pixel( GContext *ctx, GPoint point ) ;
+void graphics_draw_line( GContext *ctx, GPoint p0, GPoint p1 ) ;
+void gpath_draw_outline_open( GContext *ctx, GPath *path ) ;
+
+
+/* -----------   Platform   ----------- */
+
+#if defined(PBL_ROUND)
+  #define PBL_IF_ROUND_ELSE( if_true, if_false )   (if_true)
+  #define PBL_IF_RECT_ELSE( if_true, if_false )    (if_false)
+#else
+  #define PBL_IF_ROUND_ELSE( if_true, if_false )   (if_false)
+  #define PBL_IF_RECT_ELSE( if_true, if_false )    (if_true)
+#endif
+
+#if defined(PBL_COLOR)
+  #define PBL_IF_COLOR_ELSE( if_true, if_false )   (if_true)
+#else
+  #define PBL_IF_COLOR_ELSE( if_true, if_false )   (if_false)
+#endif
+
+
+/* -----------   Trigonometry & time   ----------- */
+
+#define TRIG_MAX_RATIO   0xffff
+#define TRIG_MAX_ANGLE   0x10000
+
+int32_t  sin_lookup( int32_t angle ) ;
+int32_t  cos_lookup( int32_t angle ) ;
+uint16_t time_ms( time_t *tloc, uint16_t *out_ms ) ;
+uint64_t host_ns( void ) ;                                      //  Host only (HOST is defined): monotonic ns, for PROFILE
+void     host_frame_record( uint32_t ns ) ;                      //  and BENCHMARK, which hands its frame times over.
+
+
+/* -----------   Logging   ----------- */
+
+typedef enum { APP_LOG_LEVEL_ERROR = 1, APP_LOG_LEVEL_WARNING = 50, APP_LOG_LEVEL_INFO = 100, APP_LOG_LEVEL_DEBUG = 200 } AppLogLevel ;
+
+void app_log( uint8_t level, const char *filename, int line, const char *fmt, ... ) ;
+
+#define APP_LOG( level, fmt, ... )   app_log( level, __FILE__, __LINE__, fmt, ##__VA_ARGS__ )
+
+
+/* -----------   Services   ----------- */
+
+typedef struct AccelData { int16_t x, y, z ; bool did_vibrate ; uint64_t timestamp ; } AccelData ;
+typedef void (*AccelDataHandler)( AccelData *data, uint32_t num_samples ) ;
+
+int  accel_service_peek( AccelData *data ) ;
+void accel_data_service_subscribe( uint32_t samples_per_update, AccelDataHandler handler ) ;
+void accel_data_service_unsubscribe( void ) ;
+
+typedef enum { SECOND_UNIT = 1 << 0, MINUTE_UNIT = 1 << 1 } TimeUnits ;
+typedef void (*TickHandler)( struct tm *tick_time, TimeUnits units_changed ) ;
+
+void tick_timer_service_subscribe( TimeUnits tick_units, TickHandler handler ) ;
+void tick_timer_service_unsubscribe( void ) ;
+
+typedef struct AppTimer AppTimer ;
+typedef void (*AppTimerCallback)( void *data ) ;
+
+AppTimer *app_timer_register( uint32_t timeout_ms, AppTimerCallback callback, void *callback_data ) ;
+void      app_timer_cancel( AppTimer *timer ) ;
+
+
+/* -----------   Windows & layers   ----------- */
+
+typedef struct Layer          Layer ;
+typedef struct Window         Window ;
+typedef struct ActionBarLayer ActionBarLayer ;
+
+typedef void (*LayerUpdateProc)( Layer *layer, GContext *ctx ) ;
+typedef void (*WindowHandler)( Window *window ) ;
+typedef struct WindowHandlers { WindowHandler load, appear, disappear, unload ; } WindowHandlers ;
+
+typedef void *ClickRecognizerRef ;
+typedef void (*ClickHandler)( ClickRecognizerRef recognizer, void *context ) ;
+typedef void (*ClickConfigProvider)( void *context ) ;
+typedef enum { BUTTON_ID_BACK, BUTTON_ID_UP, BUTTON_ID_SELECT, BUTTON_ID_DOWN } ButtonId ;
+
+Layer  *layer_create( GRect frame ) ;
+void    layer_destroy( Layer *layer ) ;
+void    layer_mark_dirty( Layer *layer ) ;
+void    layer_set_update_proc( Layer *layer, LayerUpdateProc update_proc ) ;
+void    layer_add_child( Layer *parent, Layer *child ) ;
+GRect   layer_get_frame( const Layer *layer ) ;
+GRect   layer_get_unobstructed_bounds( const Layer *layer ) ;
+
+Window *window_create( void ) ;
+void    window_destroy( Window *window ) ;
+Layer  *window_get_root_layer( const Window *window ) ;
+void    window_set_background_color( Window *window, GColor background_color ) ;
+void    window_set_window_handlers( Window *window, WindowHandlers handlers ) ;
+void    window_stack_push( Window *window, bool animated ) ;
+Window *window_stack_remove( Window *window, bool animated ) ;
+void    window_stack_pop_all( bool animated ) ;
+void    window_single_click_subscribe( ButtonId button_id, ClickHandler handler ) ;
+void    window_long_click_subscribe( ButtonId button_id, uint16_t delay_ms, ClickHandler down_handler, ClickHandler up_handler ) ;
+
+ActionBarLayer *action_bar_layer_create( void ) ;
+void            action_bar_layer_set_background_color( ActionBarLayer *action_bar, GColor background_color ) ;
+void            action_bar_layer_set_click_config_provider( ActionBarLayer *action_bar, ClickConfigProvider click_config_provider ) ;
+void            action_bar_layer_add_to_window( ActionBarLayer *action_bar, Window *window ) ;
+
+void app_event_loop( void ) ;
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Host harness: builds src/c in BENCHMARK mode (HOST defined) against the stand-ins in host/ for each platform profile, runs
+# it, and prints the BENCHMARK framebuffer fingerprint, the draw call fingerprint and the ns/frame percentiles.
+#
+# usage: host/run.sh [aplite|basalt|chalk|diorite|emery ...]        (default: all of them)
+#   ON="SWITCH ..."    main.h/Config.h switches to turn on, e.g. ON="VISIBILITY_CACHE OPAQUE_HORIZON"
+#   OFF="SWITCH ..."   switches to turn off, e.g. OFF="ANCHORED_CACHE"
+#   SRC=dir            tree to build instead of src/c (e.g. a git archive of another commit)
+#   CASES=1            ns/frame per BENCHMARK case too
+#   VERBOSE=1          every BENCHMARK log line
+#
+# Exits non zero if a build fails, or if OPAQUE_HORIZON's agreement with the ray march drops under its platform's floor.
+#   CC, CFLAGS         compiler & extra flags
+
+HOST=$(cd "$(dirname "$0")" && pwd)
+SRC=${SRC:-$HOST/../src/c}
+CC=${CC:-cc}
+WARN="-Wall -Wextra -Werror -Wno-unused-parameter -Wno-error=unused-function -Wno-error=unused-variable -Wno-implicit-fallthrough"
+PLATFORMS=${*:-aplite basalt chalk diorite emery}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+status=0
+
+for platform in $PLATFORMS
+do
+  case $platform in
+    aplite)  defs="-DPBL_PLATFORM_APLITE  -DPBL_BW    -DPBL_RECT  -DPBL_DISPLAY_WIDTH=144 -DPBL_DISPLAY_HEIGHT=168" ; horizonMin=89.5 ;;
+    basalt)  defs="-DPBL_PLATFORM_BASALT  -DPBL_COLOR -DPBL_RECT  -DPBL_DISPLAY_WIDTH=144 -DPBL_DISPLAY_HEIGHT=168" ; horizonMin=90.5 ;;
+    chalk)   defs="-DPBL_PLATFORM_CHALK   -DPBL_COLOR -DPBL_ROUND -DPBL_DISPLAY_WIDTH=180 -DPBL_DISPLAY_HEIGHT=180" ; horizonMin=93.0 ;;
+    diorite) defs="-DPBL_PLATFORM_DIORITE -DPBL_BW    -DPBL_RECT  -DPBL_DISPLAY_WIDTH=144 -DPBL_DISPLAY_HEIGHT=168" ; horizonMin=90.5 ;;
+    emery)   defs="-DPBL_PLATFORM_EMERY   -DPBL_COLOR -DPBL_RECT  -DPBL_DISPLAY_WIDTH=200 -DPBL_DISPLAY_HEIGHT=228" ; horizonMin=90.5 ;;
+    *)       echo "run.sh: unknown platform $platform" >&2 ; exit 2 ;;
+  esac
+
+  rm -rf "$TMP/src" ; mkdir "$TMP/src" ; cp "$SRC"/*.c "$SRC"/*.h "$TMP/src"
+
+  sed -i -e 's|^#define  *GIF$|//#define  GIF|' \
+         -e 's|^//#define  *BENCHMARK$|#define  BENCHMARK|' \
+         -e 's|^//#define  *LOG$|#define LOG|' "$TMP/src/Config.h"
+
+  for switch in $ON  ; do sed -i "s|^\( *\)//#define  *$switch\b|\1#define $switch|"   "$TMP/src/Config.h" "$TMP/src/main.h" ; done
+  for switch in $OFF ; do sed -i "s|^\( *\)#define  *$switch\b|\1//#define $switch|"   "$TMP/src/Config.h" "$TMP/src/main.h" ; done
+
+  $CC -std=c99 -O2 -D_DEFAULT_SOURCE -DHOST $WARN $CFLAGS $defs -I"$HOST" -I"$TMP/src" \
+      "$TMP"/src/*.c "$HOST/host.c" -lm -o "$TMP/app" || { status=1 ; continue ; }
+
+  echo "== $platform ${ON:+ON=\"$ON\"} ${OFF:+OFF=\"$OFF\"}"
+
+  "$TMP/app" > "$TMP/out"
+
+  if [ -n "$VERBOSE" ]
+  then cat "$TMP/out"
+  elif [ -n "$CASES" ]
+  then grep -E "^(benchmark:: (GRID|osc|horizon|done)|host::)" "$TMP/out"
+  else grep -E "^(benchmark:: (GRID|horizon|done)|host::)" "$TMP/out"
+  fi
+
+  # OPAQUE_HORIZON must keep agreeing with the ray march at least as much as main.h says it does.
+  agreement=$(sed -n 's/^benchmark:: horizon agreement \([0-9.]*\)%.*/\1/p' "$TMP/out")
+
+  if [ -n "$agreement" ]  &&  awk "BEGIN { exit !($agreement < $horizonMin) }"
+  then echo "run.sh: $platform OPAQUE_HORIZON agreement $agreement% is under $horizonMin%" >&2 ; status=1
+  fi
+done
+
+exit $status
@@ -17,12 +17,32 @@
 #define  GIF
 #define  GIF_STOP_COUNT     93
 
+// Uncommenting the next line will enable BENCHMARK mode: cycles through every mode combination LOGging frame timings (ms, ns on
+// the host harness) and a fingerprint of the drawn framebuffers. host/run.sh runs it on the host.
+//#define  BENCHMARK
+#define  BENCHMARK_FRAMES   64
+
+// Uncommenting the next line will enable the per stage frame PROFILE, LOGged every PROFILE_DUMP_FRAMES frames (ms on the watch,
+// ns on the host harness).
+//#define  PROFILE
+#define  PROFILE_DUMP_FRAMES   32
+
 // Commenting the next line will enable fast distro settings
 //#define EMU
 
 // Uncoment next line to use BASALT to "fake" running on APLITE/DIORITE B&W platforms with antialising on ;-)
 //#undef PBL_COLOR
 
+#if defined(BENCHMARK)
+  #if defined(GIF)
+    #error "BENCHMARK and GIF modes are mutually exclusive."
+  #endif
+
+  #if !defined(LOG)
+    #error "BENCHMARK mode reports through LOG* calls, enable LOG."
+  #endif
+#endif
+
 #if defined(LOG)
   #define LOGD(fmt, ...) APP_LOG(APP_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
   #define LOGI(fmt, ...) APP_LOG(APP_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
@@ -33,4 +53,8 @@
   #define LOGI(fmt, ...)
   #define LOGW(fmt, ...)
   #define LOGE(fmt, ...)
+#endif
+
+#if defined(PROFILE) && !defined(LOG)
+  #undef PROFILE    // PROFILE reports through LOG* calls: compile it to nothing without them.
 #endif
\ No newline at end of file
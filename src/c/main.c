@@ -71,6 +71,11 @@ static int8_t      grid_major_z         [GRID_LINES][GRID_LINES] ;       // S0.7
 static uint16_t    grid_major_dist2osc  [GRID_LINES][GRID_LINES] ;       // U4.12  Need integer part up to 11.3137 because of max diagonal distance for bouncing oscillator.
 static Visibility  grid_major_visibility[GRID_LINES][GRID_LINES] ;
 static GPoint      grid_major_screen    [GRID_LINES][GRID_LINES] ;
+#if defined(PBL_COLOR)
+static GColor      grid_major_pen       [GRID_LINES][GRID_LINES] ;       // Fuxel_color( ) of each vertex.
+#else
+static uint8_t     grid_major_pen       [GRID_LINES][GRID_LINES] ;       // Fuxel_ink( ) of each vertex, as a byte.
+#endif
 
 static int16_t     grid_minor_x         [GRID_LINES-1] ;                 // S3.12  Coords [-7.999,+7.999]
 static int16_t     grid_minor_y         [GRID_LINES-1] ;                 // S3.12  Coords [-7.999,+7.999]
@@ -78,6 +83,16 @@ static int8_t      grid_minor_z         [GRID_LINES-1][GRID_LINES-1] ;   // S0.7
 static uint16_t    grid_minor_dist2osc  [GRID_LINES-1][GRID_LINES-1] ;   // U4.12  Need integer part up to sqrt(2) * GRID_SCALE because of max diagonal distance for bouncing oscillator.
 static Visibility  grid_minor_visibility[GRID_LINES-1][GRID_LINES-1] ;
 static GPoint      grid_minor_screen    [GRID_LINES-1][GRID_LINES-1] ;
+#if defined(PBL_COLOR)
+static GColor      grid_minor_pen       [GRID_LINES-1][GRID_LINES-1] ;
+#else
+static uint8_t     grid_minor_pen       [GRID_LINES-1][GRID_LINES-1] ;
+#endif
+
+static bool        s_grid_screen_isCurrent = false ;   // Screen tables match current z, camera & pattern.
+static bool        s_grid_pen_isCurrent    = false ;   // Pen tables match current dist2osc, visibility, colorization & illumination.
+
+#define OSCILLATOR_PHASE_PERIOD   (TRIG_MAX_ANGLE >> OSCILLATOR_PHASE_SPEED)   //  Frames for oscillator_anglePhase to repeat itself.
 
 static int32_t oscillator_anglePhase ;
 static Q2      oscillator_position ;
@@ -103,7 +118,172 @@ void grid_minor_dist2osc_update( ) ;
 void grid_minor_z_update( ) ;
 void grid_minor_visibility_update( ) ;
 void grid_dist2osc_update( ) ;
+void grid_horizon_visibility_update( ) ;
+void anchored_cache_initialize( ) ;
+void anchored_cache_finalize( ) ;
+void visibility_cache_initialize( ) ;
+void visibility_cache_finalize( ) ;
 void invert_set( const bool inverted ) ;
+void palette_update( ) ;
+void screen_projection_update( ) ;
+
+
+#if defined(BENCHMARK) || defined(PROFILE)
+/***  ---------------  Clock  ---------------  ***/
+
+uint32_t
+clock_ms
+( )
+{
+  time_t    seconds ;
+  uint16_t  milliseconds ;
+
+  time_ms( &seconds, &milliseconds ) ;
+
+  return (uint32_t)seconds * 1000 + milliseconds ;
+}
+
+
+// PROFILE & BENCHMARK timestamps: ms is all the watch has, but most stages (and frames) take under one on the host harness,
+// so there they are ns.
+#if defined(HOST)
+  #define PROFILE_UNIT   "ns"
+
+  typedef uint32_t  ProfileTime ;
+  #define PROFILE_TIME_MAX   UINT32_MAX
+
+  inline
+  static
+  uint32_t
+  profile_now
+  ( )
+  { return (uint32_t)host_ns( ) ; }
+#else
+  #define PROFILE_UNIT   "ms"
+
+  typedef uint16_t  ProfileTime ;
+  #define PROFILE_TIME_MAX   UINT16_MAX
+
+  inline
+  static
+  uint32_t
+  profile_now
+  ( )
+  { return clock_ms( ) ; }
+#endif
+#endif
+
+
+/***  ---------------  Profile  ---------------  ***/
+
+#if defined(PROFILE)
+  static ProfileTime  s_profile_stageTime[PROFILE_DUMP_FRAMES][PROFILE_STAGES] ;   // Ring buffer of per frame stage durations, PROFILE_UNIT.
+  static int          s_profile_frame = 0 ;
+  static uint32_t     s_profile_counter     [PROFILE_COUNTERS] ;                     // Current frame.
+  static uint32_t     s_profile_counterMin  [PROFILE_COUNTERS] ;
+  static uint32_t     s_profile_counterMax  [PROFILE_COUNTERS] ;
+  static uint32_t     s_profile_counterTotal[PROFILE_COUNTERS] ;
+
+  static const char *s_profile_stageName[PROFILE_STAGES]     = { "oscillator", "z", "camera", "visibility", "project", "draw" } ;
+  static const char *s_profile_counterName[PROFILE_COUNTERS] = { "rays", "probes", "subdivisions", "hintTries", "hintHits", "occluderHits", "backfaces", "margins", "drawDepth", "camHolds", "visCacheHits", "visCacheMisses" } ;
+
+
+  void
+  profile_stage_add
+  ( const ProfileStage  stage
+  , const uint32_t      time
+  )
+  {
+    const uint32_t stageTime = s_profile_stageTime[s_profile_frame][stage] ;
+    s_profile_stageTime[s_profile_frame][stage] = (time > PROFILE_TIME_MAX - stageTime) ? PROFILE_TIME_MAX : stageTime + time ;
+  }
+
+
+  void
+  profile_dump
+  ( )
+  {
+    for (int s = 0  ;  s < PROFILE_STAGES  ;  ++s)
+    {
+      uint32_t min = PROFILE_TIME_MAX, max = 0 ;
+      uint64_t total = 0 ;
+
+      for (int f = 0  ;  f < PROFILE_DUMP_FRAMES  ;  ++f)
+      {
+        const uint32_t time = s_profile_stageTime[f][s] ;
+
+        if (time < min)  min = time ;
+        if (time > max)  max = time ;
+        total += time ;
+      }
+
+      LOGD( "profile:: %s min %lu avg %lu max %lu " PROFILE_UNIT
+          , s_profile_stageName[s]
+          , (unsigned long)min, (unsigned long)(total / PROFILE_DUMP_FRAMES), (unsigned long)max
+          ) ;
+    }
+
+    for (int c = 0  ;  c < PROFILE_COUNTERS  ;  ++c)
+    {
+      LOGD( "profile:: %s min %lu avg %lu max %lu per frame"
+          , s_profile_counterName[c]
+          , (unsigned long)s_profile_counterMin[c]
+          , (unsigned long)(s_profile_counterTotal[c] / PROFILE_DUMP_FRAMES)
+          , (unsigned long)s_profile_counterMax[c]
+          ) ;
+
+      s_profile_counterMin[c]   = UINT32_MAX ;
+      s_profile_counterMax[c]   = 0 ;
+      s_profile_counterTotal[c] = 0 ;
+    }
+  }
+
+
+  void
+  profile_frame_end
+  ( )
+  {
+    for (int c = 0  ;  c < PROFILE_COUNTERS  ;  ++c)
+    {
+      const uint32_t count = s_profile_counter[c] ;
+
+      if (s_profile_counterMin[c] > count)  s_profile_counterMin[c] = count ;
+      if (s_profile_counterMax[c] < count)  s_profile_counterMax[c] = count ;
+      s_profile_counterTotal[c] += count ;
+      s_profile_counter[c]       = 0 ;
+    }
+
+    if (++s_profile_frame == PROFILE_DUMP_FRAMES)
+    {
+      profile_dump( ) ;
+      s_profile_frame = 0 ;
+    }
+
+    // Clear the next ring slot to accumulate the next frame.
+    for (int s = 0  ;  s < PROFILE_STAGES  ;  ++s)
+      s_profile_stageTime[s_profile_frame][s] = 0 ;
+  }
+
+
+  void
+  profile_initialize
+  ( )
+  {
+    for (int c = 0  ;  c < PROFILE_COUNTERS  ;  ++c)
+      s_profile_counterMin[c] = UINT32_MAX ;
+  }
+
+
+  #define PROFILE_STAGE( stage, call )   { const uint32_t start = profile_now( ) ;  call ;  profile_stage_add( stage, profile_now( ) - start ) ; }
+  #define PROFILE_COUNT( counter, n )    (s_profile_counter[counter] += (n))
+  #define PROFILE_MAX( counter, n )      ((s_profile_counter[counter] < (uint32_t)(n)) ? (void)(s_profile_counter[counter] = (n)) : (void)0)
+  #define PROFILE_FRAME_END( )           profile_frame_end( )
+#else
+  #define PROFILE_STAGE( stage, call )   { call ; }
+  #define PROFILE_COUNT( counter, n )    ((void)0)
+  #define PROFILE_MAX( counter, n )      ((void)0)
+  #define PROFILE_FRAME_END( )
+#endif
 
 
 /***  ---------------  PATTERN  ---------------  ***/
@@ -115,6 +295,9 @@ pattern_set
   if (s_pattern == pattern)
     return ;
 
+  s_grid_screen_isCurrent = false ;
+  s_grid_pen_isCurrent    = false ;
+
   switch (s_pattern = pattern)
   {
     case PATTERN_DOTS:
@@ -261,6 +444,7 @@ colorization_set
     return ;
 
   s_colorization = colorization ;
+  palette_update( ) ;
 }
 
 
@@ -309,6 +493,7 @@ illumination_set
     return ;
 
   s_illumination = illumination ;
+  palette_update( ) ;
 
   #if !defined(PBL_COLOR)
     invert_set( s_pattern != PATTERN_DOTS  &&  s_illumination != ILLUMINATION_SPOTLIGHT ) ;
@@ -410,6 +595,9 @@ static int32_t  s_cam_rotZangle      = 0
              ,  s_cam_rotZangleSpeed = 0
              ,  s_cam_rotXangleSpeed = 0
              ;
+#if defined(CAM_VIEWPOINT_DEADBAND)
+  static const Q  cam_viewPoint_deadband = Q_from_float( CAM_VIEWPOINT_DEADBAND / 1000.0f ) ;   // In G, like the averaged Samplers.
+#endif
 
 
 void
@@ -468,6 +656,11 @@ cam_config
                            ) ;
 
   s_cam_viewPoint_boxing = world_boxing( s_cam.viewPoint ) ;
+  s_grid_screen_isCurrent = false ;
+
+  #if defined(SCREEN_PROJECT_BATCH)
+    screen_projection_update( ) ;
+  #endif
 }
 
 
@@ -512,6 +705,135 @@ screen_project
 }
 
 
+#if defined(SCREEN_PROJECT_BATCH)
+// screen_project( ) folded into one homogeneous 3x4 matrix per camera: rows x & y hold the camera axes scaled by zoom and
+// screen_project_scale, plus screen_project_translate times the depth row, so that screen = (row · world) / (depth · world).
+// The perspective divide is a reciprocal: a normalized depth seeds from a table, then two Newton steps refine it.
+#define SCREEN_RECIP_BITS   6     // Normalized depths live in [2^31, 2^32): table index is the 6 bits below the top one.
+
+static uint32_t screen_recip_table[1 << SCREEN_RECIP_BITS] ;   // 2^62 / depth at the middle of each slot: 1/depth in Q2.30.
+static Q3       screen_projection_row[3] ;                      // x, y, depth.
+static Q        screen_projection_column[3] ;                   // Translation: -row · viewPoint.
+
+// Grid x & y never change, only z does: the x (translation included) and y parts of (x, y, depth) are separable, cached per
+// grid line whenever the camera changes. A vertex then only adds its z part before the divide.
+static Q3       screen_major_xTerm[GRID_LINES] ;
+static Q3       screen_major_yTerm[GRID_LINES] ;
+static Q3       screen_minor_xTerm[GRID_LINES-1] ;
+static Q3       screen_minor_yTerm[GRID_LINES-1] ;
+
+
+void
+screen_recip_initialize
+( )
+{
+  for (int k = 0  ;  k < (1 << SCREEN_RECIP_BITS)  ;  ++k)
+    screen_recip_table[k] = (uint32_t)( ((uint64_t)1 << 62)
+                                      / ( ((uint64_t)((1 << SCREEN_RECIP_BITS) + k) << (31 - SCREEN_RECIP_BITS))
+                                        + ((uint64_t)1 << (30 - SCREEN_RECIP_BITS))
+                                        )
+                                      ) ;
+}
+
+
+void
+screen_terms_update
+(       Q3       *xTerm
+,       Q3       *yTerm
+, const int16_t  *x        // S3.12
+, const int16_t  *y        // S3.12
+, const int       n
+)
+{
+  for (int l = 0  ;  l < n  ;  ++l)
+  {
+    const Q  wx = x[l] << COORD_SHIFT ;
+    const Q  wy = y[l] << COORD_SHIFT ;
+
+    xTerm[l] = (Q3){ .x = Q_mul( screen_projection_row[0].x, wx ) + screen_projection_column[0]
+                   , .y = Q_mul( screen_projection_row[1].x, wx ) + screen_projection_column[1]
+                   , .z = Q_mul( screen_projection_row[2].x, wx ) + screen_projection_column[2]
+                   } ;
+    yTerm[l] = (Q3){ .x = Q_mul( screen_projection_row[0].y, wy )
+                   , .y = Q_mul( screen_projection_row[1].y, wy )
+                   , .z = Q_mul( screen_projection_row[2].y, wy )
+                   } ;
+  }
+}
+
+
+// To be called whenever the camera or the screen scale/translation change.
+// Assumes CamQ3_view( ) projects along the cam's zAxis onto its xAxis & yAxis, scaled by zoom: as host/'s CamQ3 stand-in
+// does, unverified against the real karambola (see main.h).
+void
+screen_projection_update
+( )
+{
+  const Q  k = Q_mul( screen_project_scale, s_cam.zoom ) ;
+
+  screen_projection_row[0] = (Q3){ .x = Q_mul( k, s_cam.xAxis.x ) + Q_mul( screen_project_translate.x, s_cam.zAxis.x )
+                                 , .y = Q_mul( k, s_cam.xAxis.y ) + Q_mul( screen_project_translate.x, s_cam.zAxis.y )
+                                 , .z = Q_mul( k, s_cam.xAxis.z ) + Q_mul( screen_project_translate.x, s_cam.zAxis.z )
+                                 } ;
+  screen_projection_row[1] = (Q3){ .x = Q_mul( k, s_cam.yAxis.x ) + Q_mul( screen_project_translate.y, s_cam.zAxis.x )
+                                 , .y = Q_mul( k, s_cam.yAxis.y ) + Q_mul( screen_project_translate.y, s_cam.zAxis.y )
+                                 , .z = Q_mul( k, s_cam.yAxis.z ) + Q_mul( screen_project_translate.y, s_cam.zAxis.z )
+                                 } ;
+  screen_projection_row[2] = s_cam.zAxis ;
+
+  for (int r = 0  ;  r < 3  ;  ++r)
+    screen_projection_column[r] = -(Q)( ( (int64_t)screen_projection_row[r].x * s_cam.viewPoint.x
+                                        + (int64_t)screen_projection_row[r].y * s_cam.viewPoint.y
+                                        + (int64_t)screen_projection_row[r].z * s_cam.viewPoint.z
+                                        ) >> 16
+                                      ) ;
+
+  screen_terms_update( screen_major_xTerm, screen_major_yTerm, grid_major_x, grid_major_y, GRID_LINES   ) ;
+  screen_terms_update( screen_minor_xTerm, screen_minor_yTerm, grid_minor_x, grid_minor_y, GRID_LINES-1 ) ;
+}
+
+
+// Projects the n vertices (x, y[j] S3.12, z[j] S0.7) of grid row i, given its cached x & y terms: same as screen_project( ) up
+// to the rounding of its last bit.
+void
+screen_project_row
+(       GPoint   *screen
+, const Q         x
+, const int16_t  *y
+, const int8_t   *z
+, const Q3       *xTermPtr
+, const Q3       *yTerm
+, const int       n
+)
+{
+  for (int j = 0  ;  j < n  ;  ++j)
+  {
+    const Q  wz = z[j] << Z_SHIFT ;
+    const Q  px = xTermPtr->x + yTerm[j].x + Q_mul( screen_projection_row[0].z, wz ) ;
+    const Q  py = xTermPtr->y + yTerm[j].y + Q_mul( screen_projection_row[1].z, wz ) ;
+    const Q  pd = xTermPtr->z + yTerm[j].z + Q_mul( screen_projection_row[2].z, wz ) ;
+
+    if (pd <= Q_0)
+      screen_project( &screen[j], (Q3){ .x = x, .y = y[j] << COORD_SHIFT, .z = wz } ) ;   // At/behind the camera plane.
+    else
+    {
+      const int       shift = __builtin_clz( pd ) ;
+      const uint32_t  m     = (uint32_t)pd << shift ;                                     // [2^31, 2^32)
+      uint32_t        recip = screen_recip_table[(m >> (31 - SCREEN_RECIP_BITS)) & ((1 << SCREEN_RECIP_BITS) - 1)] ;
+
+      // Newton: recip *= 2 - m * recip. In Q2.30, with m read as [0.5, 1).
+      recip = (uint32_t)(((uint64_t)recip * ((1u << 31) - (uint32_t)(((uint64_t)m * recip) >> 32))) >> 30) ;
+      recip = (uint32_t)(((uint64_t)recip * ((1u << 31) - (uint32_t)(((uint64_t)m * recip) >> 32))) >> 30) ;
+
+      //  1 / depth  ==  recip * 2^(shift - 46)  in Q.
+      screen[j].x = (int16_t)(((int64_t)px * recip) >> (46 - shift + 16)) ;
+      screen[j].y = (int16_t)(((int64_t)py * recip) >> (46 - shift + 16)) ;
+    }
+  }
+}
+#endif
+
+
 /***  ---------------  OSCILLATOR  ---------------  ***/
 
 void
@@ -608,14 +930,40 @@ oscillator_distance
 }
 
 
+#if defined(RADIAL_LUT)
+  // z only depends on distance (modulo one wave length) and on the current phase: tabulate one wave length per frame.
+  #define RADIAL_LUT_SHIFT   5                                                //  U4.12 distance units per table step: 2^5
+  #define RADIAL_LUT_SIZE    ((TRIG_MAX_ANGLE >> 3) >> RADIAL_LUT_SHIFT)      //  Wave length is 2.0, 8192 U4.12 distance units.
+
+  static int32_t radial_lut[RADIAL_LUT_SIZE + 1] ;                            //  Q  z at each step, last entry wraps to the first.
+
+
+  void
+  radial_lut_update
+  ( )
+  {
+    for (int m = 0  ;  m <= RADIAL_LUT_SIZE  ;  ++m)
+      radial_lut[m] = cos_lookup( ((m << (RADIAL_LUT_SHIFT + 3)) + oscillator_anglePhase) & 0xFFFF ) ;   //  angle = distance / 2 + anglePhase
+  }
+#endif
+
+
 inline
 static
 Q
 f_distance
 ( const Q dist )
 {
+#if defined(RADIAL_LUT)
+  const int32_t  d    = dist >> DIST_SHIFT ;                                            //  U4.12
+  const int32_t  m    = (d >> RADIAL_LUT_SHIFT) & (RADIAL_LUT_SIZE - 1) ;
+  const int32_t  frac =  d & ((1 << RADIAL_LUT_SHIFT) - 1) ;
+
+  return radial_lut[m] + (((radial_lut[m+1] - radial_lut[m]) * frac) >> RADIAL_LUT_SHIFT) ;   //  z = f( x, y ), linearly interpolated.
+#else
   const int32_t angle = ((dist >> 1) + oscillator_anglePhase) & 0xFFFF ;   //  (distance2oscillator / 2 + anglePhase) % TRIG_MAX_RATIO
   return cos_lookup( angle ) ;                                             //  z = f( x, y )
+#endif
 }
 
 
@@ -627,65 +975,214 @@ f_XY
 { return f_distance( oscillator_distance( x, y ) ) ; }
 
 
+#if defined(VISIBILITY_BACKFACE) || defined(SHADOW_MAP) || defined(TERMINATOR_SECANT)
+  #define F_PI   Q_from_float(3.1416f)
+
+  // How fast the view line from world to viewPoint clears the surface, as it leaves it: normal . (viewPoint - world), with the
+  // normal (-dz/dx, -dz/dy, 1), where grad z = -PI * sin( PI * distance + phase ) * (p - oscillator) / distance.
+  inline
+  static
+  Q
+  function_facing
+  ( const Q3 world, const Q3 viewPoint )
+  {
+    const Q  dist = oscillator_distance( world.x, world.y ) ;
+
+    if (dist <= Q_EPSILON << 6)
+      return viewPoint.z - world.z ;    //  Flat at the oscillator.
+
+    const Q  k  = Q_div( Q_mul( F_PI, sin_lookup( ((dist >> 1) + oscillator_anglePhase) & 0xFFFF ) ), dist ) ;
+    const Q  nx = Q_mul( k, world.x - oscillator_position.x ) ;
+    const Q  ny = Q_mul( k, world.y - oscillator_position.y ) ;
+
+    return Q_mul( nx, viewPoint.x - world.x ) + Q_mul( ny, viewPoint.y - world.y ) + (viewPoint.z - world.z) ;
+  }
+
+
+  // Whether the surface at world faces viewPoint.
+  inline
+  static
+  bool
+  function_isFacing
+  ( const Q3 world, const Q3 viewPoint )
+  { return function_facing( world, viewPoint ) > Q_0 ; }
+#endif
+
+
+#if defined(VISIBILITY_BACKFACE)
+  // Whether the surface at world turns its back on viewPoint, which then can't see it: from above the world box that's the top
+  // side facing away, from bellow it's the underside. From within the box's z range either side may show: never settled here.
+  inline
+  static
+  bool
+  function_isBackfacing
+  ( const Q3      world
+  , const Q3      viewPoint
+  , const Boxing  boxing      //  viewPoint's
+  )
+  {
+    if (boxing.zMajor)
+      return function_facing( world, viewPoint ) <= Q_0 ;
+
+    if (boxing.zMinor)
+      return function_facing( world, viewPoint ) >= Q_0 ;
+
+    return false ;
+  }
+#endif
+
+
+#if defined(VISIBILITY_INTERPOLATED)
+  static Q  grid_linesPerUnit ;   //  (GRID_LINES - 1) / scale: lattice steps per world unit.
+
+
+  // z := f( x, y ) bilinearly interpolated from the (current) grid_major_z lattice.
+  inline
+  static
+  Q
+  f_XY_interpolated
+  ( const Q x, const Q y )
+  {
+    Q    u = Q_mul( x - world_xMin, grid_linesPerUnit ) ;
+    Q    v = Q_mul( y - world_yMin, grid_linesPerUnit ) ;
+    int  i = u >> 16 ;
+    int  j = v >> 16 ;
+
+    //  Clamp to the lattice: clipped rays can end epsilon outside of it.
+    if (i < 0)                  { i = 0 ;             u = Q_0 ; }
+    else if (i > GRID_LINES-2)  { i = GRID_LINES-2 ;  u = Q_from_int(GRID_LINES-1) ; }
+
+    if (j < 0)                  { j = 0 ;             v = Q_0 ; }
+    else if (j > GRID_LINES-2)  { j = GRID_LINES-2 ;  v = Q_from_int(GRID_LINES-1) ; }
+
+    const Q  fu  = u - Q_from_int(i) ;
+    const Q  fv  = v - Q_from_int(j) ;
+    const Q  z00 = grid_major_z[i  ][j  ] << Z_SHIFT ;
+    const Q  z10 = grid_major_z[i+1][j  ] << Z_SHIFT ;
+    const Q  z01 = grid_major_z[i  ][j+1] << Z_SHIFT ;
+    const Q  z11 = grid_major_z[i+1][j+1] << Z_SHIFT ;
+    const Q  z0  = z00 + Q_mul( z10 - z00, fu ) ;
+    const Q  z1  = z01 + Q_mul( z11 - z01, fu ) ;
+
+    return z0 + Q_mul( z1 - z0, fv ) ;
+  }
+#endif
+
+
+// z := f( x, y ) as sampled by the visibility ray probes.
+inline
+static
+Q
+f_XY_probe
+( const Q x, const Q y )
+{
+#if defined(VISIBILITY_INTERPOLATED)
+  return f_XY_interpolated( x, y ) ;
+#else
+  return f_XY( x, y ) ;
+#endif
+}
+
+
 /***  ---------------  Hidden line removal  ---------------  ***/
 
+#if defined(VISIBILITY_INTERPOLATED)
+  #define F_SLOPE_MAX   Q_from_float(4.4429f)   //  Max |gradient| of the bilinear lattice: PI along each axis, PI * sqrt(2) overall.
+#else
+  #define F_SLOPE_MAX   Q_from_float(3.1416f)   //  Max |gradient| of z = cos( PI * distance + phase )
+#endif
+
+#if defined(VISIBILITY_OCCLUDER_CACHE)
+  // Where the last hidden vertex's cam/spotlight ray crossed the surface: most likely the same crest hides the next one too.
+  static Occluder  s_cam_occluder ;
+  static Occluder  s_spotlight_occluder ;
+
+  #define VISIBILITY_OCCLUDER( occluder )   (&(occluder))
+
+  void
+  visibility_occluder_reset
+  ( )
+  {
+    s_cam_occluder.isSet = s_spotlight_occluder.isSet = false ;
+  }
+#else
+  #define VISIBILITY_OCCLUDER( occluder )   NULL
+#endif
+
+
+// Looks for a surface crossing along the (already clipped) view line segment from point to point + point2viewer.
+static
 bool
-function_isVisible_fromPoint
+function_isVisible_alongSegment
 ( const Q3      point
-, const Q3      viewPoint
-, const Boxing  viewPointBoxing
+, const Q3      point2viewer
+, const Q       endAltitude     //  Altitude of the far end (k=1): on which side of the surface the segment must stay.
+, Q            *crossingKPtr    //  Where a crossing was found, when not visible.
 )
 {
-  Q3 point2viewer ;  Q3_sub( &point2viewer, &viewPoint, &point ) ;
-  Q  k ;
+#if defined(VISIBILITY_SPHERE_TRACING)
+  //  2) March the clipped line segment by safe steps: altitude changes by at most p2v.z -/+ F_SLOPE_MAX * |p2v.xy| per unit of k,
+  //     so from a probe the ray can't reach the surface any sooner than |altitude| / (that rate towards the surface).
 
-  //  1) Clip the view line to the nearest min/max box wall.
-  if (viewPointBoxing.xMajor)
-    k = Q_div( world_xMax - point.x, point2viewer.x ) ;
-  else if (viewPointBoxing.xMinor)
-    k = Q_div( world_xMin - point.x, point2viewer.x ) ;
-  else
-    k = Q_1 ;
+  const Q  p2vXY       = Q_sqrt( Q_mul( point2viewer.x, point2viewer.x ) + Q_mul( point2viewer.y, point2viewer.y ) ) ;
+  const Q  slopeXY     = Q_mul( F_SLOPE_MAX, p2vXY ) ;
+  const Q  fallRate    = slopeXY - point2viewer.z ;   //  Max altitude decrease per unit of k, when above the surface.
+  const Q  riseRate    = slopeXY + point2viewer.z ;   //  Max altitude increase per unit of k, when below the surface.
+  const Q  minStepK    = Q_1 >> VISIBILITY_MAX_ITERATIONS ;                   //  Same resolution as the halving steps.
 
-  Q kMin = k ;
+  for (Q probeK = minStepK  ;  probeK < Q_1  ;  )
+  {
+    PROFILE_COUNT( PROFILE_COUNTER_PROBES, 1 ) ;
 
-  if (viewPointBoxing.yMajor)
-    k = Q_div( world_yMax - point.y, point2viewer.y ) ;
-  else if (viewPointBoxing.yMinor)
-    k = Q_div( world_yMin - point.y, point2viewer.y ) ;
-  else
-    k = Q_1 ;
+    const Q  probeX        = point.x + Q_mul( probeK, point2viewer.x ) ;
+    const Q  probeY        = point.y + Q_mul( probeK, point2viewer.y ) ;
+    const Q  probeZ        = point.z + Q_mul( probeK, point2viewer.z ) ;
+    const Q  probeAltitude = probeZ - f_XY_probe( probeX, probeY ) ;
+    Q        stepK ;
 
-  if (k < kMin)
-    kMin = k ;
+    if (probeAltitude > Q_0)
+    {
+      if (endAltitude < Q_0)
+      {
+        *crossingKPtr = probeK ;
+        return false ;    // Not visible since it has both positive and negative probe altitudes (function altitude has zeros).
+      }
 
-  if (viewPointBoxing.zMajor)
-    k = Q_div( world_zMax - point.z, point2viewer.z ) ;
-  else if (viewPointBoxing.zMinor)
-    k = Q_div( world_zMin - point.z, point2viewer.z ) ;
-  else
-    k = Q_1 ;
+      if (fallRate <= Q_0)
+        return true ;     // Rising faster than any slope: stays above the surface.
 
-  if (k < kMin)
-    kMin = k ;
-  
-  // test for the point being epsilon close to the world box surface.
-  if (kMin < (Q_1>>(VISIBILITY_MAX_ITERATIONS+1)))
-    return true ;
-  
-  if (kMin < Q_1)
-    Q3_sca( &point2viewer, kMin, &point2viewer ) ;    //  Do the clipping to the nearest min/max x/y/z box wall.
+      stepK = Q_div( probeAltitude, fallRate ) ;
+    }
+    else if (probeAltitude < Q_0)
+    {
+      if (endAltitude > Q_0)
+      {
+        *crossingKPtr = probeK ;
+        return false ;    // Not visible since it has both positive and negative probe altitudes (function altitude has zeros).
+      }
+
+      if (riseRate <= Q_0)
+        return true ;     // Falling faster than any slope: stays below the surface.
 
+      stepK = Q_div( -probeAltitude, riseRate ) ;
+    }
+    else
+      stepK = minStepK ;
+
+    probeK += (stepK > minStepK) ? stepK : minStepK ;
+  }
 
+  return true ;
+#else
   //  2) Test the clipped line segment with increasingly smaller steps.
 
-  bool hasPositives = false ;
-  bool hasNegatives = false ;
+  bool hasPositives = (endAltitude > Q_0) ;
+  bool hasNegatives = (endAltitude < Q_0) ;
 
   Q3 probe , smallStep , bigStep  ;
   Q  probeK, smallStepK, bigStepK ;
 
-  for ( smallStepK = Q_1     , smallStep = point2viewer                                  //  Start with the biggest possible small step, all the way to the nearest point in the min/max box (k=1).
+  for ( smallStepK = Q_1>>1  , smallStep.x = point2viewer.x>>1, smallStep.y = point2viewer.y>>1, smallStep.z = point2viewer.z>>1   //  Start with the biggest possible small step short of the far end (k=1), already probed.
       ; smallStepK >= Q_1>>VISIBILITY_MAX_ITERATIONS                                     //  Newton (split in half) steps. TODO: refine exit criteria.
       ; smallStepK >>= 1     , smallStep.x >>= 1, smallStep.y >>= 1, smallStep.z >>= 1   //  Divide the step length in half.
       )
@@ -697,19 +1194,26 @@ function_isVisible_fromPoint
         ; probeK += bigStepK ,  Q3_add( &probe, &probe, &bigStep )
         )
     {
-      Q probeAltitude = probe.z - f_XY( probe.x, probe.y ) ;
+      PROFILE_COUNT( PROFILE_COUNTER_PROBES, 1 ) ;
+      Q probeAltitude = probe.z - f_XY_probe( probe.x, probe.y ) ;
 
       if (probeAltitude > Q_0)
       {
         if (hasNegatives)
+        {
+          *crossingKPtr = probeK ;
           return false ;    // Not visible since it has both positive and negative probe altitudes (function altitude has zeros).
+        }
 
         hasPositives = true ;
       }
       else if (probeAltitude < Q_0)
       {
         if (hasPositives)
+        {
+          *crossingKPtr = probeK ;
           return false ;    // Not visible since it has both positive and negative probe altitudes (function altitude has zeros).
+        }
 
         hasNegatives = true ;
       }
@@ -717,20 +1221,141 @@ function_isVisible_fromPoint
   }
 
   return true ;
+#endif
 }
 
 
-#if defined(GIF)
-  void world_update_timer_handler( void *data ) ;
+bool
+function_isVisible_fromPoint
+( const Q3      point
+, const Q3      viewPoint
+, const Boxing  viewPointBoxing
+, const Q       hintK           //  Where to look for a crossing first (VISIBILITY_HINTS), Q_0 for nowhere.
+, Q            *crossingKPtr    //  Where a crossing was found, when not visible.
+, Occluder     *occluderPtr     //  What hid the previous vertex (VISIBILITY_OCCLUDER_CACHE), NULL for nothing.
+)
+{
+  PROFILE_COUNT( PROFILE_COUNTER_RAYS, 1 ) ;
 
-  void
-  gifStepper_advance_click_handler
-  ( ClickRecognizerRef recognizer
-  , void              *context
-  )
-  {
-    if (s_world_updateTimer_ptr == NULL)
-      s_world_updateTimer_ptr = app_timer_register( 0, world_update_timer_handler, NULL ) ;   // Schedule a world update.
+  Q3 point2viewer ;  Q3_sub( &point2viewer, &viewPoint, &point ) ;
+  Q  k ;
+
+  //  1) Clip the view line to the nearest min/max box wall.
+  if (viewPointBoxing.xMajor)
+    k = Q_div( world_xMax - point.x, point2viewer.x ) ;
+  else if (viewPointBoxing.xMinor)
+    k = Q_div( world_xMin - point.x, point2viewer.x ) ;
+  else
+    k = Q_1 ;
+
+  Q kMin = k ;
+
+  if (viewPointBoxing.yMajor)
+    k = Q_div( world_yMax - point.y, point2viewer.y ) ;
+  else if (viewPointBoxing.yMinor)
+    k = Q_div( world_yMin - point.y, point2viewer.y ) ;
+  else
+    k = Q_1 ;
+
+  if (k < kMin)
+    kMin = k ;
+
+  if (viewPointBoxing.zMajor)
+    k = Q_div( world_zMax - point.z, point2viewer.z ) ;
+  else if (viewPointBoxing.zMinor)
+    k = Q_div( world_zMin - point.z, point2viewer.z ) ;
+  else
+    k = Q_1 ;
+
+  if (k < kMin)
+    kMin = k ;
+  
+  // test for the point being epsilon close to the world box surface.
+  if (kMin < (Q_1>>(VISIBILITY_MAX_ITERATIONS+1)))
+    return true ;
+  
+  if (kMin < Q_1)
+    Q3_sca( &point2viewer, kMin, &point2viewer ) ;    //  Do the clipping to the nearest min/max x/y/z box wall.
+
+  //  The far end first: it tells on which side of the surface the line must stay, whichever way it's searched.
+  PROFILE_COUNT( PROFILE_COUNTER_PROBES, 1 ) ;
+  const Q  endAltitude = point.z + point2viewer.z - f_XY_probe( point.x + point2viewer.x, point.y + point2viewer.y ) ;
+
+#if defined(VISIBILITY_HINTS)
+  //  Last frame's crossing: opposite altitudes there and at the far end prove a crossing in between.
+  if (hintK != Q_0)
+  {
+    PROFILE_COUNT( PROFILE_COUNTER_HINT_TRIES, 1 ) ;
+    PROFILE_COUNT( PROFILE_COUNTER_PROBES, 1 ) ;
+
+    const Q  hintAltitude = point.z + Q_mul( hintK, point2viewer.z )
+                          - f_XY_probe( point.x + Q_mul( hintK, point2viewer.x ), point.y + Q_mul( hintK, point2viewer.y ) ) ;
+
+    if ((endAltitude > Q_0  &&  hintAltitude < Q_0)  ||  (endAltitude < Q_0  &&  hintAltitude > Q_0))
+    {
+      PROFILE_COUNT( PROFILE_COUNTER_HINT_HITS, 1 ) ;
+      *crossingKPtr = hintK ;
+      return false ;
+    }
+  }
+#endif
+
+#if defined(VISIBILITY_OCCLUDER_CACHE)
+  //  The crest that hid the previous vertex: probe where the ray passes nearest to it in x,y, a crossing proven the same way.
+  if (occluderPtr != NULL  &&  occluderPtr->isSet)
+  {
+    const Q  p2vXY2 = Q_mul( point2viewer.x, point2viewer.x ) + Q_mul( point2viewer.y, point2viewer.y ) ;
+    const Q  occluderK = (p2vXY2 > (Q_1>>8))
+                       ? Q_div( Q_mul( occluderPtr->x - point.x, point2viewer.x ) + Q_mul( occluderPtr->y - point.y, point2viewer.y ), p2vXY2 )
+                       : Q_0 ;
+
+    if (occluderK > Q_0  &&  occluderK < Q_1)
+    {
+      PROFILE_COUNT( PROFILE_COUNTER_PROBES, 1 ) ;
+
+      const Q  occluderAltitude = point.z + Q_mul( occluderK, point2viewer.z )
+                                - f_XY_probe( point.x + Q_mul( occluderK, point2viewer.x ), point.y + Q_mul( occluderK, point2viewer.y ) ) ;
+
+      if ((endAltitude > Q_0  &&  occluderAltitude < Q_0)  ||  (endAltitude < Q_0  &&  occluderAltitude > Q_0))
+      {
+        PROFILE_COUNT( PROFILE_COUNTER_OCCLUDER_HITS, 1 ) ;
+        *crossingKPtr = occluderK ;
+        return false ;
+      }
+    }
+  }
+#endif
+
+  const bool  isVisible = function_isVisible_alongSegment( point, point2viewer, endAltitude, crossingKPtr ) ;
+
+#if defined(VISIBILITY_OCCLUDER_CACHE)
+  if (occluderPtr != NULL)
+  {
+    occluderPtr->isSet = !isVisible ;     //  Nothing hid this vertex: nothing to offer the next one.
+
+    if (!isVisible)
+    {
+      occluderPtr->x = point.x + Q_mul( *crossingKPtr, point2viewer.x ) ;
+      occluderPtr->y = point.y + Q_mul( *crossingKPtr, point2viewer.y ) ;
+    }
+  }
+#endif
+
+  return isVisible ;
+}
+
+
+#if defined(GIF)
+  void world_update_timer_handler( void *data ) ;
+
+  void
+  gifStepper_advance_click_handler
+  ( ClickRecognizerRef recognizer
+  , void              *context
+  )
+  {
+    if (s_world_updateTimer_ptr == NULL)
+      s_world_updateTimer_ptr = app_timer_register( 0, world_update_timer_handler, NULL ) ;   // Schedule a world update.
   }
 
   void
@@ -784,15 +1409,362 @@ function_isVisible_fromPoint
 #endif
 
 
+#if defined(SHADOW_MAP)
+/***  ---------------  Shadow map  ---------------  ***/
+
+// The spotlight is fixed and above the world box, so along a light ray z only decreases away from the light, and the first
+// surface point the ray meets is the highest one. Light rays are indexed by where they cross the z = +1 plane (q): each texel
+// keeps the highest z seen through it, rasterized from the grid cells (4 triangles around the cell center). A point is lit
+// when it faces the light and is not bellow the (bilinearly interpolated) map at its own q. Without the facing test, points just
+// past a crest (the map's flat triangles cut crests) would show through with any bias big enough for the lit side.
+
+#define SHADOW_MAP_SIZE   64                  //  Texels per side, S0.7 bytes: 4K.
+#define SHADOW_MAP_BIAS   (Q_1 >> 2)          //  Covers z quantization and the flat triangles in between grid points.
+
+static int8_t  shadow_map[SHADOW_MAP_SIZE][SHADOW_MAP_SIZE] ;   //  S0.7  Highest z seen through each texel, -1.0 when none.
+static Q       shadow_map_scale[256] ;                          //  q = L + (p - L) * scale, for each S0.7 z of p.
+static Q2      shadow_map_origin ;                              //  q at the corner of texel (0, 0).
+static Q       shadow_map_texelsPerUnit ;
+static bool    shadow_map_isCurrent = false ;                   //  Cleared whenever z changes.
+
+
+void
+shadow_map_initialize
+( )
+{
+  //  The map covers the world box and the light's own (x, y): every q lies in between them.
+  shadow_map_origin.x = (s_spotlight.x < world_xMin) ? s_spotlight.x : world_xMin ;
+  shadow_map_origin.y = (s_spotlight.y < world_yMin) ? s_spotlight.y : world_yMin ;
+
+  const Q  xMax   = (s_spotlight.x > world_xMax) ? s_spotlight.x : world_xMax ;
+  const Q  yMax   = (s_spotlight.y > world_yMax) ? s_spotlight.y : world_yMax ;
+  const Q  extent = (xMax - shadow_map_origin.x > yMax - shadow_map_origin.y) ? xMax - shadow_map_origin.x : yMax - shadow_map_origin.y ;
+
+  shadow_map_texelsPerUnit = Q_div( Q_from_int(SHADOW_MAP_SIZE), extent + Q_EPSILON ) ;
+
+  for (int z = INT8_MIN  ;  z <= INT8_MAX  ;  ++z)
+    shadow_map_scale[(uint8_t)z] = Q_div( s_spotlight.z - Q_1, s_spotlight.z - (z << Z_SHIFT) ) ;
+
+  shadow_map_isCurrent = false ;
+}
+
+
+// Texel space q of a world point with S0.7 z.
+inline
+static
+void
+shadow_map_project
+( Q3 *texelPtr, const Q x, const Q y, const int8_t z )
+{
+  const Q  scale = shadow_map_scale[(uint8_t)z] ;
+
+  texelPtr->x = Q_mul( s_spotlight.x + Q_mul( x - s_spotlight.x, scale ) - shadow_map_origin.x, shadow_map_texelsPerUnit ) ;
+  texelPtr->y = Q_mul( s_spotlight.y + Q_mul( y - s_spotlight.y, scale ) - shadow_map_origin.y, shadow_map_texelsPerUnit ) ;
+  texelPtr->z = z << Z_SHIFT ;
+}
+
+
+inline
+static
+Q
+shadow_map_edge
+( const Q3 *a, const Q3 *b, const Q x, const Q y )
+{ return Q_mul( b->x - a->x, y - a->y ) - Q_mul( b->y - a->y, x - a->x ) ; }
+
+
+// Keep the highest z of the triangle at each texel center it covers (either winding).
+void
+shadow_map_triangle
+( const Q3 *v0, const Q3 *v1, const Q3 *v2 )
+{
+  const Q  area = shadow_map_edge( v0, v1, v2->x, v2->y ) ;
+
+  if (abs( area ) < (Q_1 >> 8))
+    return ;    //  Degenerate, or too small to matter.
+
+  const Q  inverseArea = Q_div( Q_1, area ) ;
+
+  Q  xMin = v0->x, xMax = v0->x, yMin = v0->y, yMax = v0->y ;
+
+  if (v1->x < xMin)  xMin = v1->x ;
+  if (v1->x > xMax)  xMax = v1->x ;
+  if (v2->x < xMin)  xMin = v2->x ;
+  if (v2->x > xMax)  xMax = v2->x ;
+  if (v1->y < yMin)  yMin = v1->y ;
+  if (v1->y > yMax)  yMax = v1->y ;
+  if (v2->y < yMin)  yMin = v2->y ;
+  if (v2->y > yMax)  yMax = v2->y ;
+
+  //  Texels whose center (t + 1/2) is inside the bounding box.
+  int  txMin = Q_to_int( xMin - (Q_1 >> 1) + Q_1 - Q_EPSILON ) ;
+  int  txMax = Q_to_int( xMax - (Q_1 >> 1) ) ;
+  int  tyMin = Q_to_int( yMin - (Q_1 >> 1) + Q_1 - Q_EPSILON ) ;
+  int  tyMax = Q_to_int( yMax - (Q_1 >> 1) ) ;
+
+  if (txMin < 0)                  txMin = 0 ;
+  if (tyMin < 0)                  tyMin = 0 ;
+  if (txMax > SHADOW_MAP_SIZE-1)  txMax = SHADOW_MAP_SIZE-1 ;
+  if (tyMax > SHADOW_MAP_SIZE-1)  tyMax = SHADOW_MAP_SIZE-1 ;
+
+  //  Barycentric weights and z are linear in the texel center (x, y): step them along columns and rows.
+  const Q  b0dx = Q_mul( v1->y - v2->y, inverseArea ) ;
+  const Q  b0dy = Q_mul( v2->x - v1->x, inverseArea ) ;
+  const Q  b1dx = Q_mul( v2->y - v0->y, inverseArea ) ;
+  const Q  b1dy = Q_mul( v0->x - v2->x, inverseArea ) ;
+  const Q  zdx  = Q_mul( b0dx, v0->z - v2->z ) + Q_mul( b1dx, v1->z - v2->z ) ;
+  const Q  zdy  = Q_mul( b0dy, v0->z - v2->z ) + Q_mul( b1dy, v1->z - v2->z ) ;
+
+  const Q  x0   = Q_from_int(txMin) + (Q_1 >> 1) ;
+  const Q  y0   = Q_from_int(tyMin) + (Q_1 >> 1) ;
+  Q        b0x  = Q_mul( shadow_map_edge( v1, v2, x0, y0 ), inverseArea ) ;
+  Q        b1x  = Q_mul( shadow_map_edge( v2, v0, x0, y0 ), inverseArea ) ;
+  Q        zx   = v2->z + Q_mul( b0x, v0->z - v2->z ) + Q_mul( b1x, v1->z - v2->z ) ;
+
+  for (int tx = txMin  ;  tx <= txMax  ;  ++tx, b0x += b0dx, b1x += b1dx, zx += zdx)
+  {
+    Q  b0 = b0x, b1 = b1x, z = zx ;
+
+    for (int ty = tyMin  ;  ty <= tyMax  ;  ++ty, b0 += b0dy, b1 += b1dy, z += zdy)
+      if (b0 >= Q_0  &&  b1 >= Q_0  &&  b0 + b1 <= Q_1  &&  (z >> Z_SHIFT) > shadow_map[tx][ty])
+        shadow_map[tx][ty] = z >> Z_SHIFT ;
+  }
+}
+
+
+void
+shadow_map_update
+( )
+{
+  memset( shadow_map, INT8_MIN, sizeof(shadow_map) ) ;
+
+  //  Two rows of projected major vertices at a time.
+  Q3  row[2][GRID_LINES] ;
+
+  for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+    shadow_map_project( &row[0][j], grid_major_x[0] << COORD_SHIFT, grid_major_y[j] << COORD_SHIFT, grid_major_z[0][j] ) ;
+
+  for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+  {
+    Q3 *const  row0 = row[ i    & 1] ;
+    Q3 *const  row1 = row[(i+1) & 1] ;
+
+    for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+      shadow_map_project( &row1[j], grid_major_x[i+1] << COORD_SHIFT, grid_major_y[j] << COORD_SHIFT, grid_major_z[i+1][j] ) ;
+
+    for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
+    {
+      const Q   centerX = grid_minor_x[i] << COORD_SHIFT ;
+      const Q   centerY = grid_minor_y[j] << COORD_SHIFT ;
+      int8_t    centerZ   = 0 ;
+
+      switch (s_pattern)
+      {
+        case PATTERN_DOTS:
+        case PATTERN_STRIPES:
+          centerZ = grid_minor_z[i][j] ;                         //  Already current.
+        break ;
+
+        case PATTERN_LINES:
+        case PATTERN_GRID:
+        case PATTERN_UNDEFINED:
+          centerZ = f_XY( centerX, centerY ) >> Z_SHIFT ;
+        break ;
+      }
+
+      Q3  center ;  shadow_map_project( &center, centerX, centerY, centerZ ) ;
+
+      shadow_map_triangle( &center, &row0[j  ], &row1[j  ] ) ;
+      shadow_map_triangle( &center, &row1[j  ], &row1[j+1] ) ;
+      shadow_map_triangle( &center, &row1[j+1], &row0[j+1] ) ;
+      shadow_map_triangle( &center, &row0[j+1], &row0[j  ] ) ;
+    }
+  }
+
+  shadow_map_isCurrent = true ;
+}
+
+
+bool
+shadow_map_isLit
+( const Q3 world )
+{
+  if (!shadow_map_isCurrent)
+    shadow_map_update( ) ;
+
+  if (!function_isFacing( world, s_spotlight ))
+    return false ;
+
+  //  q of the point, in texel space, relative to texel centers.
+  const Q  scale = Q_div( s_spotlight.z - Q_1, s_spotlight.z - world.z ) ;
+  Q        u     = Q_mul( s_spotlight.x + Q_mul( world.x - s_spotlight.x, scale ) - shadow_map_origin.x, shadow_map_texelsPerUnit ) - (Q_1 >> 1) ;
+  Q        v     = Q_mul( s_spotlight.y + Q_mul( world.y - s_spotlight.y, scale ) - shadow_map_origin.y, shadow_map_texelsPerUnit ) - (Q_1 >> 1) ;
+
+  if (u < Q_0)                               u = Q_0 ;
+  if (v < Q_0)                               v = Q_0 ;
+  if (u > Q_from_int(SHADOW_MAP_SIZE-1) - 1)  u = Q_from_int(SHADOW_MAP_SIZE-1) - 1 ;
+  if (v > Q_from_int(SHADOW_MAP_SIZE-1) - 1)  v = Q_from_int(SHADOW_MAP_SIZE-1) - 1 ;
+
+  const int  tx  = u >> 16 ;
+  const int  ty  = v >> 16 ;
+  const Q    fu  = u & 0xFFFF ;
+  const Q    fv  = v & 0xFFFF ;
+  const Q    z00 = shadow_map[tx  ][ty  ] << Z_SHIFT ;
+  const Q    z10 = shadow_map[tx+1][ty  ] << Z_SHIFT ;
+  const Q    z01 = shadow_map[tx  ][ty+1] << Z_SHIFT ;
+  const Q    z11 = shadow_map[tx+1][ty+1] << Z_SHIFT ;
+  const Q    z0  = z00 + Q_mul( z10 - z00, fu ) ;
+  const Q    z1  = z01 + Q_mul( z11 - z01, fu ) ;
+
+  return world.z + SHADOW_MAP_BIAS >= z0 + Q_mul( z1 - z0, fv ) ;
+}
+#endif
+
+
 /***  ---------------  oscillator---------  ***/
 
 static Q   dy2[GRID_LINES] ;   // Auxiliary array.
 
 
+#if defined(DIST_TABLE)
+/***  ---------------  Distance table  ---------------  ***/
+
+// Vertex to oscillator squared distances are separable (dx2 + dy2), only their square root needs work: a squared
+// distance, normalized by an even shift, indexes a table of square roots that gets linearly interpolated.
+#define DIST_TABLE_FIRST   64    // Normalized squared distances live in [2^30, 2^32): table index is their top 8 bits.
+#define DIST_TABLE_LAST    256
+
+static uint32_t dist_table[DIST_TABLE_LAST - DIST_TABLE_FIRST + 1] ;   // sqrt( k ) * 2^16
+
+
+void
+dist_table_initialize
+( )
+{
+  for (int k = DIST_TABLE_FIRST  ;  k <= DIST_TABLE_LAST  ;  ++k)
+    dist_table[k - DIST_TABLE_FIRST] = Q_sqrt( Q_from_int(k) ) ;
+}
+
+
+// U4.12 distance for a Q squared distance, same as Q_sqrt( square ) >> DIST_SHIFT within 1 LSB.
+inline
+static
+uint16_t
+dist_fromSquare
+( const Q square )
+{
+  if (square <= 0)
+    return 0 ;
+
+  const int      shift  = __builtin_clz( square ) & ~1 ;                 // Even: sqrt( square << shift ) == sqrt( square ) << shift/2
+  const uint32_t n      = (uint32_t)square << shift ;                     // [2^30, 2^32)
+  const uint32_t k      = n >> 24 ;
+  const uint32_t frac   = (n >> 8) & 0xFFFF ;
+  const uint32_t *tPtr  = &dist_table[k - DIST_TABLE_FIRST] ;
+  const uint32_t root   = tPtr[0] + (((tPtr[1] - tPtr[0]) * frac) >> 16) ;   // sqrt( n ) * 2^4
+
+  //  Q_sqrt( square ) >> DIST_SHIFT  ==  sqrt( square ) * 2^4  ==  root >> shift/2
+  return root >> (shift >> 1) ;
+}
+#endif
+
+
+#if defined(OCTANT_SYMMETRY)
+/***  ---------------  Octant symmetry  ---------------  ***/
+
+// Grid lines fold around the center into distances a = 0, 1, ... from it, an octant slot holds (a, b) with a >= b.
+// The octant is evaluated then mirrored into the full tables, which it adds to: fewer Q_sqrt( ) & f_distance( ) calls, not
+// less RAM.
+#define OCTANT_HALF(lines)    (((lines) + 1) / 2)
+#define OCTANT_SLOTS(lines)   ((OCTANT_HALF(lines) * (OCTANT_HALF(lines) + 1)) / 2)
+
+static uint16_t  octant_major_dist2osc[OCTANT_SLOTS(GRID_LINES)] ;     // U4.12
+static uint16_t  octant_minor_dist2osc[OCTANT_SLOTS(GRID_LINES-1)] ;   // U4.12
+static bool      octant_major_isCurrent = false ;                      // Oscillator was at the center on the last grid_major_dist2osc_update( ).
+static bool      octant_minor_isCurrent = false ;                      // Oscillator was at the center on the last grid_minor_dist2osc_update( ).
+
+
+inline
+static
+int
+octant_fold
+( const int l, const int lines )
+{ return (l < (lines >> 1)) ? ((lines - 1) >> 1) - l : l - (lines >> 1) ; }
+
+
+inline
+static
+int
+octant_slot
+( const int a, const int b )
+{ return (a >= b) ? ((a * (a + 1)) >> 1) + b : ((b * (b + 1)) >> 1) + a ; }
+
+
+// Evaluates the octant (with the same arithmetic as the full update) then mirrors it all over the grid.
+void
+octant_dist2osc_update
+( const int16_t  *coord
+, const int       lines
+, uint16_t       *octant
+, uint16_t       *table    // [lines][lines]
+)
+{
+  for (int a = 0  ;  a < OCTANT_HALF(lines)  ;  ++a)
+  {
+    const Q da    = Q_0 - (coord[(lines >> 1) + a] << COORD_SHIFT) ;
+    const Q da2_a = Q_mul( da, da ) ;
+
+    for (int b = 0  ;  b <= a  ;  ++b)
+    {
+      const Q db = Q_0 - (coord[(lines >> 1) + b] << COORD_SHIFT) ;
+      octant[octant_slot( a, b )] = Q_sqrt( da2_a + Q_mul( db, db ) ) >> DIST_SHIFT ;
+    }
+  }
+
+  for (int i = 0  ;  i < lines  ;  ++i)
+  {
+    const int a = octant_fold( i, lines ) ;
+
+    for (int j = 0  ;  j < lines  ;  ++j)
+      table[i * lines + j] = octant[octant_slot( a, octant_fold( j, lines ) )] ;
+  }
+}
+
+
+void
+octant_z_update
+( const int        lines
+, const uint16_t  *octant
+, int8_t          *table    // [lines][lines]
+)
+{
+  int8_t octantZ[OCTANT_SLOTS(GRID_LINES)] ;
+
+  for (int slot = 0  ;  slot < OCTANT_SLOTS(lines)  ;  ++slot)
+    octantZ[slot] = f_distance( octant[slot] << DIST_SHIFT ) >> Z_SHIFT ;
+
+  for (int i = 0  ;  i < lines  ;  ++i)
+  {
+    const int a = octant_fold( i, lines ) ;
+
+    for (int j = 0  ;  j < lines  ;  ++j)
+      table[i * lines + j] = octantZ[octant_slot( a, octant_fold( j, lines ) )] ;
+  }
+}
+#endif
+
+
 void
 grid_major_dist2osc_update
 ( )
 {
+  #if defined(OCTANT_SYMMETRY)
+    if ((octant_major_isCurrent = (oscillator_position.x == Q_0  &&  oscillator_position.y == Q_0)))
+    {
+      octant_dist2osc_update( grid_major_x, GRID_LINES, octant_major_dist2osc, &grid_major_dist2osc[0][0] ) ;
+      return ;
+    }
+  #endif
+
   for (int j = 0  ;  j < GRID_LINES  ;  j++)
   {
     const Q dy = oscillator_position.y - (grid_major_y[j] << COORD_SHIFT) ;
@@ -805,7 +1777,11 @@ grid_major_dist2osc_update
     const Q dx2_i = Q_mul( dx, dx ) ;
 
     for (int j = 0  ;  j < GRID_LINES  ;  j++)
-      grid_major_dist2osc[i][j] = Q_sqrt( dx2_i + dy2[j] ) >> DIST_SHIFT ;
+      #if defined(DIST_TABLE)
+        grid_major_dist2osc[i][j] = dist_fromSquare( dx2_i + dy2[j] ) ;
+      #else
+        grid_major_dist2osc[i][j] = Q_sqrt( dx2_i + dy2[j] ) >> DIST_SHIFT ;
+      #endif
   }
 }
 
@@ -814,6 +1790,14 @@ void
 grid_minor_dist2osc_update
 ( )
 {
+  #if defined(OCTANT_SYMMETRY)
+    if ((octant_minor_isCurrent = (oscillator_position.x == Q_0  &&  oscillator_position.y == Q_0)))
+    {
+      octant_dist2osc_update( grid_minor_x, GRID_LINES-1, octant_minor_dist2osc, &grid_minor_dist2osc[0][0] ) ;
+      return ;
+    }
+  #endif
+
   for (int j = 0  ;  j < GRID_LINES-1  ;  j++)
   {
     const Q dy = oscillator_position.y - (grid_minor_y[j] << COORD_SHIFT) ;
@@ -826,7 +1810,11 @@ grid_minor_dist2osc_update
     const Q dx2_i = Q_mul( dx, dx ) ;
 
     for (int j = 0  ;  j < GRID_LINES-1  ;  j++)
-      grid_minor_dist2osc[i][j] = Q_sqrt( dx2_i + dy2[j] ) >> DIST_SHIFT ;
+      #if defined(DIST_TABLE)
+        grid_minor_dist2osc[i][j] = dist_fromSquare( dx2_i + dy2[j] ) ;
+      #else
+        grid_minor_dist2osc[i][j] = Q_sqrt( dx2_i + dy2[j] ) >> DIST_SHIFT ;
+      #endif
   }
 }
 
@@ -862,20 +1850,49 @@ grid_initialize
   world_xMax = world_yMax = +grid_halfScale ;
   world_zMin = -(world_zMax = Q_1 + Q_EPSILON) ;
 
+  #if defined(DIST_TABLE)
+    dist_table_initialize( ) ;
+  #endif
+
+  #if defined(SCREEN_PROJECT_BATCH)
+    screen_recip_initialize( ) ;
+  #endif
+
+  #if defined(VISIBILITY_INTERPOLATED)
+    grid_linesPerUnit = Q_div( Q_from_int(GRID_LINES - 1), grid_scale ) ;
+  #endif
+
   int l ;
   Q   lCoord ;
 
+  // Coords are mirrored around 0 (instead of accumulated all the way) so that the grid is exactly symmetric, which
+  // ANCHORED_CACHE's distance classes & OCTANT_SYMMETRY rely on. On every build this moves the far side lines by up to
+  // 3 LSB (3/4096) from where accumulating put them.
   for ( l = 0          , lCoord = -grid_halfScale
-      ; l < GRID_LINES
+      ; l < GRID_LINES/2
       ; l++            , lCoord += distanceBetweenLines
       )
-    grid_major_x[l] = grid_major_y[l] = lCoord >> COORD_SHIFT ;
+  {
+    grid_major_x[l]              = grid_major_y[l]              =   lCoord >> COORD_SHIFT ;
+    grid_major_x[GRID_LINES-1-l] = grid_major_y[GRID_LINES-1-l] = -(lCoord >> COORD_SHIFT) ;
+  }
+
+  #if (GRID_LINES & 1)
+    grid_major_x[GRID_LINES/2] = grid_major_y[GRID_LINES/2] = 0 ;
+  #endif
 
   for ( l = 0          , lCoord = -grid_halfScale + (distanceBetweenLines >> 1)
-      ; l < GRID_LINES-1
+      ; l < (GRID_LINES-1)/2
       ; l++            , lCoord += distanceBetweenLines
       )
-    grid_minor_x[l] = grid_minor_y[l] = lCoord >> COORD_SHIFT ;
+  {
+    grid_minor_x[l]              = grid_minor_y[l]              =   lCoord >> COORD_SHIFT ;
+    grid_minor_x[GRID_LINES-2-l] = grid_minor_y[GRID_LINES-2-l] = -(lCoord >> COORD_SHIFT) ;
+  }
+
+  #if ((GRID_LINES-1) & 1)
+    grid_minor_x[(GRID_LINES-1)/2] = grid_minor_y[(GRID_LINES-1)/2] = 0 ;
+  #endif
 }
 
 
@@ -914,12 +1931,16 @@ static GColor     s_color_background ;
       s_colorMap[1] = GColorGreen ;
       s_colorMap[0] = GColorVividCerulean ;
     #endif
+
+    palette_update( ) ;
   }
 
 
   GColor
-  Fuxel_color
-  ( const Fuxel  *fPtr )
+  pen_color
+  ( const int   band         //  (2 * distance) % 8
+  , const bool  spotlight
+  )
   {
     GColor color = s_color_background ;
 
@@ -934,7 +1955,7 @@ static GColor     s_color_background ;
       break ;
 
       case COLORIZATION_DISTANCE:
-        color = s_colorMap[(fPtr->dist2osc >> 15) & 0b111] ;      //  (2 * distance) % 8
+        color = s_colorMap[band] ;
       break ;
     }
 
@@ -947,7 +1968,7 @@ static GColor     s_color_background ;
         return color ;
 
       case ILLUMINATION_SPOTLIGHT:
-        return fPtr->visibility.spotlight ? color : GColorDarkGray ;
+        return spotlight ? color : GColorDarkGray ;
     }
 
     return color ;   //  Will never reach this line, just to mute compiler error.
@@ -959,12 +1980,16 @@ static GColor     s_color_background ;
   {
     s_color_stroke     = GColorBlack ;
     s_color_background = GColorWhite ;
+
+    palette_update( ) ;
   }
 
 
   ink_t
-  Fuxel_ink
-  ( const Fuxel  *fPtr )
+  pen_ink
+  ( const int   band         //  (2 * distance) % 8
+  , const bool  spotlight
+  )
   {
     ink_t ink = INK0 ;
 
@@ -979,7 +2004,7 @@ static GColor     s_color_background ;
       break ;
 
       case COLORIZATION_DISTANCE:
-        ink = ((fPtr->dist2osc >> 15) & 0b1) ? INK50 : INK100 ;
+        ink = (band & 0b1) ? INK50 : INK100 ;
       break ;
     }
 
@@ -992,7 +2017,7 @@ static GColor     s_color_background ;
         return ink ;
 
       case ILLUMINATION_SPOTLIGHT:
-        return fPtr->visibility.spotlight ? ink : INK33 ;
+        return spotlight ? ink : INK33 ;
     }
 
     return ink ;   //  Will never reach this line, just to mute compiler error.
@@ -1019,17 +2044,142 @@ static GColor     s_color_background ;
       window_set_background_color          ( s_window          , s_color_background ) ;
       action_bar_layer_set_background_color( s_action_bar_layer, s_color_background ) ;
     }
+
+    palette_update( ) ;
   }
 #endif
 
 
+// Pens by spotlight visibility & distance band, rebuilt whenever colorization, illumination or inversion change:
+// resolving a Fuxel's pen is then a single indexed load.
+static union Pen  s_palette[2 * 8] ;
+
+#define PALETTE_INDEX( fPtr )   (((fPtr)->visibility.spotlight << 3) | (((fPtr)->dist2osc >> 15) & 0b111))
+
+
 void
-world_initialize
+palette_update
 ( )
 {
-  pattern_set( PATTERN_DEFAULT ) ;
-  grid_initialize( ) ;
-  color_initialize( ) ;
+  for (int band = 0  ;  band < 8  ;  ++band)
+  {
+    #if defined(PBL_COLOR)
+      s_palette[band    ].color = pen_color( band, false ) ;
+      s_palette[band | 8].color = pen_color( band, true  ) ;
+    #else
+      s_palette[band    ].ink   = pen_ink( band, false ) ;
+      s_palette[band | 8].ink   = pen_ink( band, true  ) ;
+    #endif
+  }
+
+  s_grid_pen_isCurrent = false ;
+}
+
+
+#if defined(PBL_COLOR)
+  inline
+  static
+  GColor
+  Fuxel_color
+  ( const Fuxel  *fPtr )
+  { return s_palette[PALETTE_INDEX( fPtr )].color ; }
+#else
+  inline
+  static
+  ink_t
+  Fuxel_ink
+  ( const Fuxel  *fPtr )
+  { return s_palette[PALETTE_INDEX( fPtr )].ink ; }
+#endif
+
+
+/***  ---------------  Pens  ---------------  ***/
+
+// Classify each vertex once per frame: every draw pass (X/Y lines, pixels, XRAY) reads its pen from these tables.
+void
+grid_major_pen_update
+( )
+{
+  for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+    for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+    {
+      const Fuxel f = (Fuxel){ .dist2osc   = grid_major_dist2osc[i][j] << DIST_SHIFT
+                             , .visibility = grid_major_visibility[i][j]
+                             }
+      ;
+
+      #if defined(PBL_COLOR)
+        grid_major_pen[i][j] = Fuxel_color( &f ) ;
+      #else
+        grid_major_pen[i][j] = Fuxel_ink( &f ) ;
+      #endif
+    }
+}
+
+
+void
+grid_minor_pen_update
+( )
+{
+  for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+    for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
+    {
+      const Fuxel f = (Fuxel){ .dist2osc   = grid_minor_dist2osc[i][j] << DIST_SHIFT
+                             , .visibility = grid_minor_visibility[i][j]
+                             }
+      ;
+
+      #if defined(PBL_COLOR)
+        grid_minor_pen[i][j] = Fuxel_color( &f ) ;
+      #else
+        grid_minor_pen[i][j] = Fuxel_ink( &f ) ;
+      #endif
+    }
+}
+
+
+void
+grid_pen_update
+( )
+{
+  switch (s_pattern)
+  {
+    case PATTERN_UNDEFINED:
+    break ;
+
+    case PATTERN_DOTS:
+    case PATTERN_STRIPES:
+      grid_minor_pen_update( ) ;
+
+    case PATTERN_LINES:
+    case PATTERN_GRID:
+      grid_major_pen_update( ) ;
+    break ;
+  }
+
+  s_grid_pen_isCurrent = true ;
+}
+
+
+void
+world_initialize
+( )
+{
+  pattern_set( PATTERN_DEFAULT ) ;
+  grid_initialize( ) ;
+  color_initialize( ) ;
+
+#if defined(RADIAL_LUT)
+  radial_lut_update( ) ;
+#endif
+
+#if defined(ANCHORED_CACHE)
+  anchored_cache_initialize( ) ;
+#endif
+
+#if defined(VISIBILITY_CACHE)
+  visibility_cache_initialize( ) ;
+#endif
 
   colorization_set( COLORIZATION_DEFAULT ) ;
   illumination_set( ILLUMINATION_DEFAULT ) ;
@@ -1043,15 +2193,160 @@ world_initialize
 
   cam_initialize( ) ;
   light_initialize( ) ;
+
+#if defined(SHADOW_MAP)
+  shadow_map_initialize( ) ;
+#endif
+
+#if defined(PROFILE)
+  profile_initialize( ) ;
+#endif
 }
 
 
+/***  ---------------  Anchored cache  ---------------  ***/
+
+#if defined(ANCHORED_CACHE)
+  #define ANCHORED_CLASSES_MAX      256
+
+  // With the oscillator anchored at the origin every vertex distance is one of a few distinct values (classes),
+  // so each phase needs only one z per class.
+  static uint8_t   grid_major_class[GRID_LINES][GRID_LINES] ;          // Index into anchored_classDist.
+  static uint8_t   grid_minor_class[GRID_LINES-1][GRID_LINES-1] ;      // Index into anchored_classDist.
+  static uint16_t  anchored_classDist[ANCHORED_CLASSES_MAX] ;          // U4.12  Distinct vertex distances to the anchored oscillator.
+  static int       anchored_classes = 0 ;
+  static int8_t   *anchored_z       = NULL ;                           // S0.7   [OSCILLATOR_PHASE_PERIOD][anchored_classes]
+  static bool      anchored_zIsCached[OSCILLATOR_PHASE_PERIOD] ;
+
+
+  int
+  anchored_class
+  ( const uint16_t dist )
+  {
+    for (int c = 0  ;  c < anchored_classes  ;  ++c)
+      if (anchored_classDist[c] == dist)
+        return c ;
+
+    if (anchored_classes == ANCHORED_CLASSES_MAX)
+      return -1 ;   // No room for a new class.
+
+    anchored_classDist[anchored_classes] = dist ;
+    return anchored_classes++ ;
+  }
+
+
+  inline
+  static
+  uint16_t
+  anchored_dist
+  ( const int16_t x, const int16_t y )
+  {
+    // Same as grid_*_dist2osc_update( ) with oscillator_position at the origin.
+    const Q dx = Q_0 - (x << COORD_SHIFT) ;
+    const Q dy = Q_0 - (y << COORD_SHIFT) ;
+
+    return Q_sqrt( Q_mul( dx, dx ) + Q_mul( dy, dy ) ) >> DIST_SHIFT ;
+  }
+
+
+  void
+  anchored_cache_initialize
+  ( )
+  {
+    anchored_classes = 0 ;
+
+    for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+      for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+      {
+        const int c = anchored_class( anchored_dist( grid_major_x[i], grid_major_y[j] ) ) ;
+
+        if (c < 0)
+          return ;   // Too many distinct distances: leave the cache off.
+
+        grid_major_class[i][j] = c ;
+      }
+
+    for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+      for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
+      {
+        const int c = anchored_class( anchored_dist( grid_minor_x[i], grid_minor_y[j] ) ) ;
+
+        if (c < 0)
+          return ;   // Too many distinct distances: leave the cache off.
+
+        grid_minor_class[i][j] = c ;
+      }
+
+    if ((anchored_z = malloc( OSCILLATOR_PHASE_PERIOD * anchored_classes )) == NULL)
+    {
+      LOGW( "anchored_cache_initialize:: no memory for %d classes", anchored_classes ) ;
+      return ;
+    }
+
+    for (int p = 0  ;  p < OSCILLATOR_PHASE_PERIOD  ;  ++p)
+      anchored_zIsCached[p] = false ;
+
+    LOGD( "anchored_cache_initialize:: %d classes, %d bytes", anchored_classes, OSCILLATOR_PHASE_PERIOD * anchored_classes ) ;
+  }
+
+
+  void
+  anchored_cache_finalize
+  ( )
+  {
+    free( anchored_z ) ;
+    anchored_z = NULL ;
+  }
+
+
+  // Per class z values for the current oscillator_anglePhase, computed on the first visit of each phase.
+  const int8_t*
+  anchored_z_get
+  ( )
+  {
+    const int  phase = ((TRIG_MAX_ANGLE - oscillator_anglePhase) & 0xFFFF) >> OSCILLATOR_PHASE_SPEED ;
+    int8_t    *zPtr  = anchored_z + phase * anchored_classes ;
+
+    if (!anchored_zIsCached[phase])
+    {
+      for (int c = 0  ;  c < anchored_classes  ;  ++c)
+        zPtr[c] = f_distance( anchored_classDist[c] << DIST_SHIFT ) >> Z_SHIFT ;
+
+      anchored_zIsCached[phase] = true ;
+    }
+
+    return zPtr ;
+  }
+#endif
+
+
 // UPDATE WORLD OBJECTS PROPERTIES
 
 void
 grid_major_z_update
 ( )
 {
+  #if defined(ANCHORED_CACHE)
+    if (s_oscillator == OSCILLATOR_ANCHORED  &&  anchored_z != NULL)
+    {
+      const int8_t *z = anchored_z_get( ) ;
+
+      for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+        for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+          grid_major_z[i][j] = z[grid_major_class[i][j]] ;
+
+      return ;
+    }
+  #endif
+
+  #if defined(OCTANT_SYMMETRY)
+    if (octant_major_isCurrent)
+    {
+      octant_z_update( GRID_LINES, octant_major_dist2osc, &grid_major_z[0][0] ) ;
+      return ;
+    }
+  #endif
+
   for (int i = 0  ;  i < GRID_LINES  ;  ++i)
     for (int j = 0  ;  j < GRID_LINES  ;  ++j)
       grid_major_z[i][j] = f_distance( grid_major_dist2osc[i][j] << DIST_SHIFT ) >> Z_SHIFT ;
@@ -1062,6 +2357,27 @@ void
 grid_minor_z_update
 ( )
 {
+  #if defined(ANCHORED_CACHE)
+    if (s_oscillator == OSCILLATOR_ANCHORED  &&  anchored_z != NULL)
+    {
+      const int8_t *z = anchored_z_get( ) ;
+
+      for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+        for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
+          grid_minor_z[i][j] = z[grid_minor_class[i][j]] ;
+
+      return ;
+    }
+  #endif
+
+  #if defined(OCTANT_SYMMETRY)
+    if (octant_minor_isCurrent)
+    {
+      octant_z_update( GRID_LINES-1, octant_minor_dist2osc, &grid_minor_z[0][0] ) ;
+      return ;
+    }
+  #endif
+
   for (int i = 0  ;  i < GRID_LINES-1  ;  i++)
     for (int j = 0  ;  j < GRID_LINES-1  ;  j++)
       grid_minor_z[i][j] = f_distance( grid_minor_dist2osc[i][j] << DIST_SHIFT ) >> Z_SHIFT ;
@@ -1072,6 +2388,10 @@ void
 grid_z_update
 ( )
 {
+  #if defined(SHADOW_MAP)
+    shadow_map_isCurrent = false ;
+  #endif
+
   switch (s_pattern)
   {
     case PATTERN_DOTS:
@@ -1089,13 +2409,129 @@ grid_z_update
 }
 
 
+// Spotlight visibility, given an already known cam visibility.
+#if defined(VISIBILITY_HINTS)
+  #define VISIBILITY_HINT_SHIFT   10                                    //  Hints keep the crossing k in 1/64 steps.
+  #define VISIBILITY_HINT_K( hint )   ((hint) ? ((Q)(hint) << VISIBILITY_HINT_SHIFT) + (1 << (VISIBILITY_HINT_SHIFT - 1)) : Q_0)
+
+  // 6 bit hint for next frame: where the ray crossed the surface, 0 when visible.
+  inline
+  static
+  uint8_t
+  visibility_hint
+  ( const bool isVisible, const Q crossingK )
+  {
+    const int32_t  hint = crossingK >> VISIBILITY_HINT_SHIFT ;
+
+    return isVisible ? 0 : (hint < 1) ? 1 : (hint > 63) ? 63 : hint ;
+  }
+#else
+  #define VISIBILITY_HINT_K( hint )   Q_0
+#endif
+
+
+#if defined(VISIBILITY_CACHE)
+/***  ---------------  Visibility cache  ---------------  ***/
+
+// With the oscillator anchored and the spotlight fixed, spotlight visibility only depends on z, which repeats every
+// OSCILLATOR_PHASE_PERIOD frames: the first visibility_cache_phases keep, per grid vertex, the outcome of its spotlight ray.
+// The cam orbits, so a vertex hidden from it (spotlight not marched) only becomes known on a later visit of the phase.
+
+#define VISIBILITY_CACHE_VERTICES   (GRID_LINES*GRID_LINES + (GRID_LINES-1)*(GRID_LINES-1))
+#define VISIBILITY_CACHE_BYTES      ((VISIBILITY_CACHE_VERTICES + 7) >> 3)
+
+static uint8_t  *visibility_cache        = NULL ;   // [visibility_cache_phases][2][VISIBILITY_CACHE_BYTES]  Known & lit bits per phase.
+static int       visibility_cache_phases = 0 ;      // VISIBILITY_CACHE_PHASES, or less if the heap was short.
+static uint8_t  *visibility_cache_known = NULL ;    // Current phase's known bits, NULL when not caching this frame.
+static uint8_t  *visibility_cache_lit   = NULL ;    // Current phase's lit bits.
+
+
+void
+visibility_cache_initialize
+( )
+{
+  // Fewer phases still save their share of the rays: halve until it fits.
+  for (visibility_cache_phases = VISIBILITY_CACHE_PHASES  ;  visibility_cache_phases > 0  ;  visibility_cache_phases >>= 1)
+    if ((visibility_cache = malloc( visibility_cache_phases * 2 * VISIBILITY_CACHE_BYTES )) != NULL)
+      break ;
+
+  if (visibility_cache == NULL)
+  {
+    LOGW( "visibility_cache_initialize:: no memory for %d phases", VISIBILITY_CACHE_PHASES ) ;
+    return ;
+  }
+
+  memset( visibility_cache, 0, visibility_cache_phases * 2 * VISIBILITY_CACHE_BYTES ) ;
+  LOGD( "visibility_cache_initialize:: %d phases, %d bytes", visibility_cache_phases, visibility_cache_phases * 2 * VISIBILITY_CACHE_BYTES ) ;
+}
+
+
 void
-Visibility_set
+visibility_cache_finalize
+( )
+{
+  free( visibility_cache ) ;
+  visibility_cache = visibility_cache_known = visibility_cache_lit = NULL ;
+}
+
+
+// Points the known/lit bits at the current phase's, if it is one of the cached ones. Called by every grid visibility pass,
+// as the modes may have changed since the last one.
+void
+visibility_cache_select
+( )
+{
+  const int  phase = ((TRIG_MAX_ANGLE - oscillator_anglePhase) & 0xFFFF) >> OSCILLATOR_PHASE_SPEED ;
+
+  if ( visibility_cache != NULL
+    && s_oscillator    == OSCILLATOR_ANCHORED
+    && s_illumination  == ILLUMINATION_SPOTLIGHT
+    && phase            < visibility_cache_phases
+     )
+  {
+    visibility_cache_known = visibility_cache + phase * 2 * VISIBILITY_CACHE_BYTES ;
+    visibility_cache_lit   = visibility_cache_known + VISIBILITY_CACHE_BYTES ;
+  }
+  else
+    visibility_cache_known = visibility_cache_lit = NULL ;
+}
+
+
+// Bit index of a grid vertex's Visibility, -1 for any other (e.g. a line subdivision's).
+inline
+static
+int
+visibility_cache_vertex
+( const Visibility *visibilityPtr )
+{
+  const Visibility *major = &grid_major_visibility[0][0] ;
+  const Visibility *minor = &grid_minor_visibility[0][0] ;
+
+  if (visibilityPtr >= major  &&  visibilityPtr < major + GRID_LINES*GRID_LINES)
+    return visibilityPtr - major ;
+
+  if (visibilityPtr >= minor  &&  visibilityPtr < minor + (GRID_LINES-1)*(GRID_LINES-1))
+    return GRID_LINES*GRID_LINES + (visibilityPtr - minor) ;
+
+  return -1 ;
+}
+#endif
+
+
+void
+Visibility_spotlight_set
 ( Visibility *visibilityPtr
 , Q3          world
 )
 {
-  visibilityPtr->cam = function_isVisible_fromPoint( world, s_cam.viewPoint, s_cam_viewPoint_boxing ) ;
+#if !defined(SHADOW_MAP)
+  Q  crossingK = Q_0 ;
+
+  #if defined(VISIBILITY_CACHE)
+    const int      vertex = (visibility_cache_known != NULL) ? visibility_cache_vertex( visibilityPtr ) : -1 ;
+    const uint8_t  mask   = 1 << (vertex & 7) ;
+  #endif
+#endif
 
   if (visibilityPtr->cam)
     switch (s_illumination)
@@ -1106,7 +2542,43 @@ Visibility_set
       break ;
 
       case ILLUMINATION_SPOTLIGHT:
-        visibilityPtr->spotlight = function_isVisible_fromPoint( world, s_spotlight, s_spotlight_boxing ) ;
+      #if defined(SHADOW_MAP)
+        visibilityPtr->spotlight = shadow_map_isLit( world ) ;
+      #else
+        #if defined(VISIBILITY_CACHE)
+          if (vertex >= 0  &&  (visibility_cache_known[vertex >> 3] & mask))
+          {
+            PROFILE_COUNT( PROFILE_COUNTER_VIS_CACHE_HITS, 1 ) ;
+            visibilityPtr->spotlight = (visibility_cache_lit[vertex >> 3] & mask) != 0 ;
+            break ;
+          }
+        #endif
+
+        #if defined(VISIBILITY_BACKFACE)
+          if (function_isBackfacing( world, s_spotlight, s_spotlight_boxing ))
+          {
+            PROFILE_COUNT( PROFILE_COUNTER_BACKFACES, 1 ) ;
+            visibilityPtr->spotlight = false ;
+          }
+          else
+        #endif
+            visibilityPtr->spotlight = function_isVisible_fromPoint( world, s_spotlight, s_spotlight_boxing, VISIBILITY_HINT_K( visibilityPtr->spotlightHint ), &crossingK, VISIBILITY_OCCLUDER( s_spotlight_occluder ) ) ;
+
+        #if defined(VISIBILITY_HINTS)
+          visibilityPtr->spotlightHint = visibility_hint( visibilityPtr->spotlight, crossingK ) ;
+        #endif
+
+        #if defined(VISIBILITY_CACHE)
+          if (vertex >= 0)
+          {
+            PROFILE_COUNT( PROFILE_COUNTER_VIS_CACHE_MISSES, 1 ) ;
+            visibility_cache_known[vertex >> 3] |= mask ;
+
+            if (visibilityPtr->spotlight)
+              visibility_cache_lit[vertex >> 3] |= mask ;
+          }
+        #endif
+      #endif
       break ;
     }
   else
@@ -1115,35 +2587,221 @@ Visibility_set
 
 
 void
-grid_major_visibility_update
-( )
+Visibility_cam_set
+( Visibility *visibilityPtr
+, Q3          world
+)
 {
-  switch (s_transparency)
-  {
-    case TRANSPARENCY_UNDEFINED:
-    break ;
+  Q  crossingK = Q_0 ;
 
-    case TRANSPARENCY_TRANSLUCENT:
-      // Already set to true in transparency_set( )
-    break ;
+#if defined(VISIBILITY_BACKFACE)
+  if (function_isBackfacing( world, s_cam.viewPoint, s_cam_viewPoint_boxing ))
+  {
+    PROFILE_COUNT( PROFILE_COUNTER_BACKFACES, 1 ) ;
+    visibilityPtr->cam = false ;      //  Facing away: the view line dives into the surface right away.
+  }
+  else
+#endif
+    visibilityPtr->cam = function_isVisible_fromPoint( world, s_cam.viewPoint, s_cam_viewPoint_boxing, VISIBILITY_HINT_K( visibilityPtr->camHint ), &crossingK, VISIBILITY_OCCLUDER( s_cam_occluder ) ) ;
 
-    case TRANSPARENCY_XRAY:
-    case TRANSPARENCY_OPAQUE:
-      for (int i = 0  ;  i < GRID_LINES  ;  ++i)
-      {
-        const Q  grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+  #if defined(VISIBILITY_HINTS)
+    visibilityPtr->camHint = visibility_hint( visibilityPtr->cam, crossingK ) ;
+  #endif
+}
 
-        for (int j = 0  ;  j < GRID_LINES  ;  ++j)
-        {
-          Q3 world = (Q3){ .x = grid_major_x_i
-                         , .y = grid_major_y[j] << COORD_SHIFT
-                         , .z = grid_major_z[i][j] << Z_SHIFT
-                         } ;
 
-          Visibility_set( &grid_major_visibility[i][j], world ) ;
-        }
-      }
-    break ;
+void
+Visibility_set
+( Visibility *visibilityPtr
+, Q3          world
+)
+{
+  Visibility_cam_set( visibilityPtr, world ) ;
+  Visibility_spotlight_set( visibilityPtr, world ) ;
+}
+
+
+#if defined(VISIBILITY_COARSE_STRIDE)
+/***  ---------------  Coarse to fine visibility  ---------------  ***/
+
+// Visibility is ray marched on every VISIBILITY_COARSE_STRIDE-th line first, then the stride is halved down to 1. A block is
+// settled, separately for cam and spotlight, when its 4 corners agree. A vertex new to the finer stride copies a corner of its
+// block(s) where they're all settled and is ray marched otherwise. Occluders thinner than the stride can be missed.
+
+// Line index of the k-th line at stride: the last line closes the grid.
+#define COARSE_LINE( k, stride, lines )   (((k) * (stride) < (lines) - 1) ? (k) * (stride) : (lines) - 1)
+
+#define COARSE_SETTLED_CAM         1
+#define COARSE_SETTLED_SPOTLIGHT   2
+
+
+static
+Q3
+grid_coarse_world
+( const int16_t *coordX
+, const int16_t *coordY
+, const int8_t  *z
+, const int      lines
+, const int      i
+, const int      j
+)
+{
+  return (Q3){ .x = coordX[i] << COORD_SHIFT
+             , .y = coordY[j] << COORD_SHIFT
+             , .z = z[i * lines + j] << Z_SHIFT
+             } ;
+}
+
+
+// Range of the blocks (at stride) line i belongs to: 2 when it's one of their shared lines.
+static
+void
+grid_coarse_blocks
+( const int  i
+, const int  stride
+, const int  blocks
+, const int  lines
+, int       *b0Ptr
+, int       *b1Ptr
+)
+{
+  if (i == lines - 1)
+    *b0Ptr = *b1Ptr = blocks - 1 ;
+  else if (i % stride == 0)
+  {
+    *b0Ptr = (i / stride > 0) ? i / stride - 1 : 0 ;
+    *b1Ptr = (i / stride < blocks) ? i / stride : blocks - 1 ;
+  }
+  else
+    *b0Ptr = *b1Ptr = i / stride ;
+}
+
+
+void
+grid_coarse_visibility_update
+( const int16_t *coordX
+, const int16_t *coordY
+, const int8_t  *z
+, Visibility    *visibility
+, const int      lines
+)
+{
+  int  stride = VISIBILITY_COARSE_STRIDE ;
+  int  blocks = (lines - 2) / stride + 1 ;       //  Blocks per side: ceil( (lines-1) / stride )
+
+  //  1) Coarsest vertices are all ray marched.
+  for (int ki = 0  ;  ki <= blocks  ;  ++ki)
+  {
+    #if defined(VISIBILITY_OCCLUDER_CACHE)
+      visibility_occluder_reset( ) ;
+    #endif
+
+    for (int kj = 0  ;  kj <= blocks  ;  ++kj)
+    {
+      const int  i = COARSE_LINE( ki, stride, lines ) ;
+      const int  j = COARSE_LINE( kj, stride, lines ) ;
+
+      Visibility_set( &visibility[i * lines + j], grid_coarse_world( coordX, coordY, z, lines, i, j ) ) ;
+    }
+  }
+
+  //  2) Halve the stride: settle the blocks, then copy or ray march the vertices new to the finer stride.
+  for ( ;  stride > 1  ;  stride >>= 1, blocks = (lines - 2) / stride + 1)
+  {
+    uint8_t  settled[GRID_LINES/2 + 1][GRID_LINES/2 + 1] ;
+
+    for (int bi = 0  ;  bi < blocks  ;  ++bi)
+      for (int bj = 0  ;  bj < blocks  ;  ++bj)
+      {
+        const int         i0 = COARSE_LINE( bi  , stride, lines ) ;
+        const int         i1 = COARSE_LINE( bi+1, stride, lines ) ;
+        const int         j0 = COARSE_LINE( bj  , stride, lines ) ;
+        const int         j1 = COARSE_LINE( bj+1, stride, lines ) ;
+        const Visibility  v0 = visibility[i0 * lines + j0] ;
+        const Visibility  v1 = visibility[i0 * lines + j1] ;
+        const Visibility  v2 = visibility[i1 * lines + j0] ;
+        const Visibility  v3 = visibility[i1 * lines + j1] ;
+
+        settled[bi][bj] = ((v0.cam       == v1.cam       &&  v0.cam       == v2.cam       &&  v0.cam       == v3.cam      ) ? COARSE_SETTLED_CAM       : 0)
+                        | ((v0.spotlight == v1.spotlight &&  v0.spotlight == v2.spotlight &&  v0.spotlight == v3.spotlight) ? COARSE_SETTLED_SPOTLIGHT : 0) ;
+      }
+
+    const int  half = stride >> 1 ;
+
+    for (int i = 0  ;  i < lines  ;  i = (i + half < lines - 1) ? i + half : (i < lines - 1) ? lines - 1 : lines)
+      for (int j = 0  ;  j < lines  ;  j = (j + half < lines - 1) ? j + half : (j < lines - 1) ? lines - 1 : lines)
+      {
+        if ((i % stride == 0  ||  i == lines - 1)  &&  (j % stride == 0  ||  j == lines - 1))
+          continue ;    //  Already known at the coarser stride.
+
+        int  bi0, bi1, bj0, bj1 ;
+
+        grid_coarse_blocks( i, stride, blocks, lines, &bi0, &bi1 ) ;
+        grid_coarse_blocks( j, stride, blocks, lines, &bj0, &bj1 ) ;
+
+        const uint8_t     isSettled = settled[bi0][bj0] & settled[bi0][bj1] & settled[bi1][bj0] & settled[bi1][bj1] ;
+        const Visibility  corner    = visibility[COARSE_LINE( bi0, stride, lines ) * lines + COARSE_LINE( bj0, stride, lines )] ;
+        Visibility       *vPtr      = &visibility[i * lines + j] ;
+        const Q3          world     = grid_coarse_world( coordX, coordY, z, lines, i, j ) ;
+
+        if (isSettled & COARSE_SETTLED_CAM)
+          vPtr->cam = corner.cam ;
+        else
+          Visibility_cam_set( vPtr, world ) ;
+
+        //  Settled spotlight: lit corners are cam visible too, but unlit ones may only be cam hidden.
+        if ((isSettled & COARSE_SETTLED_SPOTLIGHT)  &&  ((isSettled & COARSE_SETTLED_CAM)  ||  corner.spotlight))
+          vPtr->spotlight = corner.spotlight  &&  vPtr->cam ;
+        else
+          Visibility_spotlight_set( vPtr, world ) ;
+      }
+  }
+}
+#endif
+
+
+void
+grid_major_visibility_update
+( )
+{
+  #if defined(VISIBILITY_CACHE)
+    visibility_cache_select( ) ;
+  #endif
+
+  switch (s_transparency)
+  {
+    case TRANSPARENCY_UNDEFINED:
+    break ;
+
+    case TRANSPARENCY_TRANSLUCENT:
+      // Already set to true in transparency_set( )
+    break ;
+
+    case TRANSPARENCY_XRAY:
+    case TRANSPARENCY_OPAQUE:
+    #if defined(VISIBILITY_COARSE_STRIDE)
+      grid_coarse_visibility_update( grid_major_x, grid_major_y, &grid_major_z[0][0], &grid_major_visibility[0][0], GRID_LINES ) ;
+    #else
+      for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+      {
+        const Q  grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+
+        #if defined(VISIBILITY_OCCLUDER_CACHE)
+          visibility_occluder_reset( ) ;    //  A new line: the previous vertex is far away.
+        #endif
+
+        for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+        {
+          Q3 world = (Q3){ .x = grid_major_x_i
+                         , .y = grid_major_y[j] << COORD_SHIFT
+                         , .z = grid_major_z[i][j] << Z_SHIFT
+                         } ;
+
+          Visibility_set( &grid_major_visibility[i][j], world ) ;
+        }
+      }
+    #endif
+    break ;
   }
 }
 
@@ -1152,6 +2810,10 @@ void
 grid_minor_visibility_update
 ( )
 {
+  #if defined(VISIBILITY_CACHE)
+    visibility_cache_select( ) ;
+  #endif
+
   switch (s_transparency)
   {
     case TRANSPARENCY_UNDEFINED:
@@ -1163,10 +2825,17 @@ grid_minor_visibility_update
 
     case TRANSPARENCY_XRAY:
     case TRANSPARENCY_OPAQUE:
+    #if defined(VISIBILITY_COARSE_STRIDE)
+      grid_coarse_visibility_update( grid_minor_x, grid_minor_y, &grid_minor_z[0][0], &grid_minor_visibility[0][0], GRID_LINES-1 ) ;
+    #else
       for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
       {
         const Q  grid_minor_x_i = grid_minor_x[i] << COORD_SHIFT ;
 
+        #if defined(VISIBILITY_OCCLUDER_CACHE)
+          visibility_occluder_reset( ) ;    //  A new line: the previous vertex is far away.
+        #endif
+
         for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
         {
           Q3 world = (Q3){ .x = grid_minor_x_i
@@ -1177,6 +2846,7 @@ grid_minor_visibility_update
           Visibility_set( &grid_minor_visibility[i][j], world ) ;
         }
       }
+    #endif
     break ;
   }
 }
@@ -1186,6 +2856,14 @@ void
 grid_visibility_update
 ( )
 {
+  #if defined(OPAQUE_HORIZON)
+    if (s_transparency == TRANSPARENCY_OPAQUE)
+    {
+      grid_horizon_visibility_update( ) ;
+      return ;
+    }
+  #endif
+
   switch (s_pattern)
   {
     case PATTERN_DOTS:
@@ -1203,6 +2881,22 @@ grid_visibility_update
 }
 
 
+int
+accel_peek
+( AccelData *data )
+{
+  #if defined(BENCHMARK)
+    // Scripted wrist wobble around the STEADY viewPoint attractor: same input sequence on every run.
+    data->x =  -81 + (sin_lookup( s_world_updateCount << 9 ) >> 10) ;   //  +/- 64 mG
+    data->y = -816 + (cos_lookup( s_world_updateCount << 8 ) >> 10) ;   //  +/- 64 mG
+    data->z = -571 ;
+    return 0 ;
+  #else
+    return accel_service_peek( data ) ;
+  #endif
+}
+
+
 void
 position_setFromSensors
 ( Q2 *positionPtr )
@@ -1213,7 +2907,7 @@ position_setFromSensors
   #else
     AccelData ad ;
   
-    if (accel_service_peek( &ad ) < 0)         // Accel service not available.
+    if (accel_peek( &ad ) < 0)         // Accel service not available.
       *positionPtr = Q2_origin ;
     else
     {
@@ -1237,7 +2931,7 @@ acceleration_setFromSensors
 {
   AccelData ad ;
 
-  if (accel_service_peek( &ad ) < 0)         // Accel service not available.
+  if (accel_peek( &ad ) < 0)         // Accel service not available.
     *accelerationPtr = Q2_origin ;
   else
   {
@@ -1258,7 +2952,7 @@ viewPoint_setFromSensors
     // Non GIF => Interactive: use acelerometer to affect camera's view point position.
     AccelData ad ;
 
-    if (accel_service_peek( &ad ) < 0)         // Accel service not available.
+    if (accel_peek( &ad ) < 0)         // Accel service not available.
     {
       Sampler_push( accelSampler_x,  -81 ) ;   // STEADY viewPoint attractor.
       Sampler_push( accelSampler_y, -816 ) ;   // STEADY viewPoint attractor.
@@ -1310,10 +3004,29 @@ camera_update
     break ;
 
     case OSCILLATOR_ANCHORED:
+    {
+    #if defined(CAM_VIEWPOINT_DEADBAND)
+      Q3  viewPoint ;
+      viewPoint_setFromSensors( &viewPoint ) ;
+
+      // Hold the viewpoint while the averaged accelerometer only moves within the dead-band.
+      const bool isMoved = abs( viewPoint.x - s_cam_viewPoint.x ) > cam_viewPoint_deadband
+                        || abs( viewPoint.y - s_cam_viewPoint.y ) > cam_viewPoint_deadband
+                        || abs( viewPoint.z - s_cam_viewPoint.z ) > cam_viewPoint_deadband
+                        ;
+
+      if (isMoved)
+        s_cam_viewPoint = viewPoint ;
+      else
+        PROFILE_COUNT( PROFILE_COUNTER_CAM_HOLDS, 1 ) ;
+    #else
       viewPoint_setFromSensors( &s_cam_viewPoint ) ;
+    #endif
+
       s_cam_rotZangle += s_cam_rotZangleSpeed ;  s_cam_rotZangle &= 0xFFFF ;        // Keep angle normalized.
       s_cam_rotXangle += s_cam_rotXangleSpeed ;  s_cam_rotXangle &= 0xFFFF ;        // Keep angle normalized.
       cam_config( s_cam_viewPoint, s_cam_rotZangle, s_cam_rotXangle ) ;
+    }
     break ;
   }
 }
@@ -1325,6 +3038,10 @@ oscillator_update
 {
   oscillator_anglePhase = TRIG_MAX_ANGLE - ((s_world_updateCount << OSCILLATOR_PHASE_SPEED) & 0xFFFF) ;   //  2*PI - (256 * s_world_updateCount) % TRIG_MAX_RATIO
 
+  #if defined(RADIAL_LUT)
+    radial_lut_update( ) ;
+  #endif
+
   switch (s_oscillator)
   {
     case OSCILLATOR_ANCHORED:
@@ -1394,17 +3111,126 @@ world_update
 ( )
 {
   ++s_world_updateCount ;   //   "Master clock" for everything.
+  s_grid_screen_isCurrent = false ;
+  s_grid_pen_isCurrent    = false ;
 
-  oscillator_update( ) ;
-  grid_z_update( ) ;
-  camera_update( ) ;
-  grid_visibility_update( ) ;
+  PROFILE_STAGE( PROFILE_STAGE_OSCILLATOR, oscillator_update( )      ) ;
+  PROFILE_STAGE( PROFILE_STAGE_Z,          grid_z_update( )          ) ;
+  PROFILE_STAGE( PROFILE_STAGE_CAMERA,     camera_update( )          ) ;
+  PROFILE_STAGE( PROFILE_STAGE_VISIBILITY, grid_visibility_update( ) ) ;
 
   // this will queue a defered call to the world_draw( ) method.
   layer_mark_dirty( s_world_layer ) ;
 }
 
 
+#if defined(FRAMEBUFFER_DRAW)
+/***  ---------------  Framebuffer drawing  ---------------  ***/
+
+// world_draw( ) captures the framebuffer for frames with dot passes, which grid_draw( ) always runs first: their dots are
+// written straight into it, instead of a stroke color + graphics_draw_pixel( ) call each (the same pixel either way, dots are
+// never antialiased). The first line drawn releases it: lines keep going through the GContext, for its antialiasing & for
+// Draw2D_line_pattern( )'s dither.
+
+static GBitmap  *draw_fb = NULL ;                          //  Captured framebuffer, NULL while drawing through the GContext.
+static uint8_t  *draw_fbRow    [PBL_DISPLAY_HEIGHT] ;      //  Row data: a byte per pixel (colour) or a bit per pixel, LSB first (1 bit).
+static int16_t   draw_fbRowMinX[PBL_DISPLAY_HEIGHT] ;      //  Drawable columns of each row (round displays are narrower top & bottom).
+static int16_t   draw_fbRowMaxX[PBL_DISPLAY_HEIGHT] ;
+static int16_t   draw_fbHeight = 0 ;
+
+
+void
+draw_fb_capture
+( GContext *gCtx )
+{
+  if ((draw_fb = graphics_capture_frame_buffer( gCtx )) == NULL)
+    return ;    //  Draw through the GContext.
+
+  const GRect  bounds = gbitmap_get_bounds( draw_fb ) ;
+
+  draw_fbHeight = (bounds.size.h < PBL_DISPLAY_HEIGHT) ? bounds.size.h : PBL_DISPLAY_HEIGHT ;
+
+  for (int y = 0  ;  y < draw_fbHeight  ;  ++y)
+  {
+    #if defined(PBL_ROUND)
+      const GBitmapDataRowInfo  rowInfo = gbitmap_get_data_row_info( draw_fb, y ) ;
+
+      draw_fbRow[y]     = rowInfo.data ;
+      draw_fbRowMinX[y] = rowInfo.min_x ;
+      draw_fbRowMaxX[y] = rowInfo.max_x ;
+    #else
+      draw_fbRow[y]     = gbitmap_get_data( draw_fb ) + y * gbitmap_get_bytes_per_row( draw_fb ) ;
+      draw_fbRowMinX[y] = 0 ;
+      draw_fbRowMaxX[y] = bounds.size.w - 1 ;
+    #endif
+  }
+}
+
+
+void
+draw_fb_release
+( GContext *gCtx )
+{
+  if (draw_fb != NULL)
+  {
+    graphics_release_frame_buffer( gCtx, draw_fb ) ;
+    draw_fb = NULL ;
+  }
+}
+
+
+inline
+static
+void
+draw_fb_pixel
+( const int     x
+, const int     y
+, const GColor  color
+)
+{
+  if (y < 0  ||  y >= draw_fbHeight  ||  x < draw_fbRowMinX[y]  ||  x > draw_fbRowMaxX[y])
+    return ;    //  Off screen, as graphics_draw_pixel( ) clips it.
+
+  #if defined(PBL_COLOR)
+    draw_fbRow[y][x] = color.argb ;
+  #else
+    if (gcolor_equal( color, GColorWhite ))
+      draw_fbRow[y][x >> 3] |=  (1 << (x & 7)) ;
+    else
+      draw_fbRow[y][x >> 3] &= ~(1 << (x & 7)) ;
+  #endif
+}
+
+
+#endif
+
+
+// A grid dot, through the framebuffer when captured. On PBL_BW color is s_color_stroke, already the GContext's.
+inline
+static
+void
+draw_pixel
+( GContext     *gCtx
+, const GPoint  point
+, const GColor  color
+)
+{
+  #if defined(FRAMEBUFFER_DRAW)
+    if (draw_fb != NULL)
+    {
+      draw_fb_pixel( point.x, point.y, color ) ;
+      return ;
+    }
+  #endif
+
+  #if defined(PBL_COLOR)
+    graphics_context_set_stroke_color( gCtx, color ) ;
+  #endif
+
+  graphics_draw_pixel( gCtx, point ) ;
+}
+
+
 void
 grid_major_drawPixel
 ( GContext *gCtx )
@@ -1420,15 +3246,10 @@ grid_major_drawPixel
       if (f_visibility.cam)
       {
         #if defined(PBL_COLOR)
-          Fuxel f = (Fuxel){ .dist2osc   = grid_major_dist2osc[i][j] << DIST_SHIFT
-                           , .visibility = f_visibility
-                           }
-          ;
-
-          graphics_context_set_stroke_color( gCtx, Fuxel_color( &f ) ) ;
+          draw_pixel( gCtx, grid_major_screen[i][j], grid_major_pen[i][j] ) ;
+        #else
+          draw_pixel( gCtx, grid_major_screen[i][j], s_color_stroke ) ;
         #endif
-
-        graphics_draw_pixel( gCtx, grid_major_screen[i][j] ) ;
       }
     }
   }
@@ -1450,15 +3271,10 @@ grid_minor_drawPixel
       if (f_visibility.cam)
       {
         #if defined(PBL_COLOR)
-          Fuxel f = (Fuxel){ .dist2osc   = grid_minor_dist2osc[i][j] << DIST_SHIFT
-                           , .visibility = f_visibility
-                           }
-          ;
-
-          graphics_context_set_stroke_color( gCtx, Fuxel_color( &f ) ) ;
+          draw_pixel( gCtx, grid_minor_screen[i][j], grid_minor_pen[i][j] ) ;
+        #else
+          draw_pixel( gCtx, grid_minor_screen[i][j], s_color_stroke ) ;
         #endif
-
-        graphics_draw_pixel( gCtx, grid_minor_screen[i][j] ) ;
       }
     }
   }
@@ -1480,15 +3296,10 @@ grid_major_drawPixel_XRAY
       if (!f_visibility.cam)
       {
         #if defined(PBL_COLOR)
-          Fuxel f = (Fuxel){ .dist2osc   = grid_major_dist2osc[i][j] << DIST_SHIFT
-                           , .visibility = f_visibility
-                           }
-          ;
-
-          graphics_context_set_stroke_color( gCtx, Fuxel_color( &f ) ) ;
+          draw_pixel( gCtx, grid_major_screen[i][j], grid_major_pen[i][j] ) ;
+        #else
+          draw_pixel( gCtx, grid_major_screen[i][j], s_color_stroke ) ;
         #endif
-
-        graphics_draw_pixel( gCtx, grid_major_screen[i][j] ) ;
       }
     }
   }
@@ -1510,31 +3321,29 @@ grid_minor_drawPixel_XRAY
       if (!f_visibility.cam)
       {
         #if defined(PBL_COLOR)
-          Fuxel f = (Fuxel){ .dist2osc   = grid_minor_dist2osc[i][j] << DIST_SHIFT
-                           , .visibility = f_visibility
-                           }
-          ;
-
-          graphics_context_set_stroke_color( gCtx, Fuxel_color( &f ) ) ;
+          draw_pixel( gCtx, grid_minor_screen[i][j], grid_minor_pen[i][j] ) ;
+        #else
+          draw_pixel( gCtx, grid_minor_screen[i][j], s_color_stroke ) ;
         #endif
-
-        graphics_draw_pixel( gCtx, grid_minor_screen[i][j] ) ;
       }
     }
   }
 }
 
 
+inline
+static
 bool
 Fuxel_visualyIdentical
 ( const Fuxel *f1Ptr
 , const Fuxel *f2Ptr
+, const bool   isFine     //  DETAIL_FINE: pens must match too.
 )
 {
   if (f1Ptr->visibility.cam != f2Ptr->visibility.cam)
     return false ;
 
-  if (s_detail == DETAIL_FINE)
+  if (isFine)
   {
     #if defined(PBL_COLOR)
       return gcolor_equal( f1Ptr->pen.color, f2Ptr->pen.color ) ;
@@ -1547,93 +3356,314 @@ Fuxel_visualyIdentical
 }
 
 
-void
-function_draw_line
-(       GContext *gCtx
-, const Fuxel    *f0Ptr
-, const Fuxel    *f1Ptr
-, const bool      zoomIn
+/***  ---------------  Line drawing  ---------------  ***/
+
+// function_draw_line( ) subdivides with an explicit stack of the pending right hand ends, and draws each resulting span as it
+// comes, setting its pen.
+// The stack is a guard rather than a limit: BENCHMARK never goes deeper than 8 (zoom-in & TERMINATOR_SECANT included). A segment
+// met with a full stack is drawn as it is.
+
+#define DRAW_STACK_SIZE   16
+
+static Fuxel  draw_stack[DRAW_STACK_SIZE] ;
+
+
+#if defined(TERMINATOR_SECANT)
+/***  ---------------  Terminator search  ---------------  ***/
+
+// A cam (or spotlight) terminator where the surface turns away from the viewer (a silhouette) is a root of its near field occlusion
+// margin, function_facing( ): smooth and ray free, so regula falsi steps on it bracket the terminator much faster than halving with
+// a full Fuxel (ray marches included) at every level. Terminators cast by a farther crest aren't roots of it and are still halved.
+
+#define TERMINATOR_SECANT_STEPS   4       //  Margin evaluations per bracketing, before handing the bracket back to function_draw_line( ).
+
+// Cam or spotlight near field occlusion margin of a Fuxel, evaluated on first use.
+static
+Q
+Fuxel_margin
+( Fuxel      *fPtr
+, const bool  isSpotlight
 )
 {
-  if (f0Ptr->visibility.cam || f1Ptr->visibility.cam)    //  One of the points is visible ?
+  Q *marginPtr = isSpotlight ? &fPtr->spotlightMargin : &fPtr->camMargin ;
+
+  if (*marginPtr == Q_0)
   {
-    if (zoomIn || !Fuxel_visualyIdentical( f0Ptr, f1Ptr ))   //  Is there any cam/spotlight terminator to find ?
-    {
-      // Calculate screen distance between f0 & f1.
-      int sdx = f0Ptr->screen.x - f1Ptr->screen.x  ;  if (sdx < 0) sdx = -sdx ;   // Abs delta screen x.
-      int sdy = f0Ptr->screen.y - f1Ptr->screen.y  ;  if (sdy < 0) sdy = -sdy ;   // Abs delta screen y.
-    
-      if ((sdx + sdy) > LINE_PRECISION_PXL)   // Screen distance still too far apart ?
-      {
-        // Need to recursively zoom in on.
-        Fuxel  half ;
-
-        half.world.x  = (f0Ptr->world.x + f1Ptr->world.x) >> 1 ;
-        half.world.y  = (f0Ptr->world.y + f1Ptr->world.y) >> 1 ;
-        half.dist2osc = oscillator_distance( half.world.x, half.world.y ) ;
-        half.world.z  = f_distance( half.dist2osc ) ;
-        Visibility_set( &half.visibility, half.world ) ;
-        screen_project( &half.screen, half.world ) ;
-      
-        #if defined(PBL_COLOR)
-          half.pen.color = Fuxel_color( &half ) ;
-        #else
-          half.pen.ink   = Fuxel_ink( &half ) ;
-        #endif
-      
-        function_draw_line( gCtx, f0Ptr, &half, zoomIn ) ;
-        function_draw_line( gCtx, &half, f1Ptr, zoomIn ) ;
-        return ;
-      }
-    }
-  
-    // We reach this point because either there are no color terminators between f0 & f1,
-    // or the screen distance is close enough to avoid needing to find them.
-    #if defined(PBL_COLOR)
-      graphics_context_set_stroke_color( gCtx, f0Ptr->visibility.cam ? f0Ptr->pen.color : f1Ptr->pen.color ) ;
-      graphics_draw_line( gCtx, f0Ptr->screen, f1Ptr->screen ) ;
-    #else
-      Draw2D_line_pattern( gCtx
-                         , f0Ptr->screen.x, f0Ptr->screen.y
-                         , f1Ptr->screen.x, f1Ptr->screen.y
-                         , f0Ptr->visibility.cam ? f0Ptr->pen.ink : f1Ptr->pen.ink
-                         ) ;
-    #endif
+    PROFILE_COUNT( PROFILE_COUNTER_MARGINS, 1 ) ;
+    *marginPtr = function_facing( fPtr->world, isSpotlight ? s_spotlight : s_cam.viewPoint ) ;
   }
+
+  return *marginPtr ;
 }
 
 
-// x parallel line form function point (Fuxel) f0 to f1.
+// Surface point at t along f0 -> f1, margins not yet evaluated.
+static
 void
-grid_major_drawLineX
-( GContext *gCtx
-, int       j
+Fuxel_lerp
+( Fuxel       *fPtr
+, const Fuxel *f0Ptr
+, const Fuxel *f1Ptr
+, const Q      t
 )
 {
-  Fuxel f0, f1 ;
-  const Q grid_major_y_j = grid_major_y[j] << COORD_SHIFT ;
+  fPtr->world.x         = f0Ptr->world.x + Q_mul( t, f1Ptr->world.x - f0Ptr->world.x ) ;
+  fPtr->world.y         = f0Ptr->world.y + Q_mul( t, f1Ptr->world.y - f0Ptr->world.y ) ;
+  fPtr->dist2osc        = oscillator_distance( fPtr->world.x, fPtr->world.y ) ;
+  fPtr->world.z         = f_distance( fPtr->dist2osc ) ;
+  fPtr->camMargin       = Q_0 ;
+  fPtr->spotlightMargin = Q_0 ;
+}
 
-  f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x[0] << COORD_SHIFT
-                                  , .y = grid_major_y_j
-                                  , .z = grid_major_z[0][j] << Z_SHIFT
-                                  }
-              , .dist2osc   = grid_major_dist2osc[0][j] << DIST_SHIFT
-              , .visibility = grid_major_visibility[0][j]
-              , .screen     = grid_major_screen[0][j]
-              }
-  ;
+
+// Finishes a terminator bracket end like a halving midpoint: ray marched visibility, screen position and pen.
+static
+void
+Fuxel_terminator_set
+( Fuxel       *fPtr
+, const Fuxel *f0Ptr
+)
+{
+  #if defined(VISIBILITY_HINTS)
+    fPtr->visibility = f0Ptr->visibility ;   //  Neighbour's crossings make a good first guess.
+  #endif
+
+  Visibility_set( &fPtr->visibility, fPtr->world ) ;
+
+  screen_project( &fPtr->screen, fPtr->world ) ;
 
   #if defined(PBL_COLOR)
-    f1.pen.color = Fuxel_color( &f1 ) ;
+    fPtr->pen.color = Fuxel_color( fPtr ) ;
   #else
-    f1.pen.ink   = Fuxel_ink( &f1 ) ;
+    fPtr->pen.ink   = Fuxel_ink( fPtr ) ;
   #endif
+}
 
-  for (int i = 1  ;  i < GRID_LINES ;  ++i)
+
+// Brackets the cam (or spotlight) terminator between f0 & f1 by regula falsi steps on the near field occlusion margin, pushing the
+// bracket ends (the ones inside f0 -> f1) for function_draw_line( ) to go on with. False if the margins don't bracket a root.
+bool
+function_terminator_push
+( const Fuxel *f0Ptr
+, const Fuxel *f1Ptr
+, const bool   isSpotlight
+, const int    screenDistance
+, int         *depthPtr
+)
+{
+  Fuxel  a = *f0Ptr ;
+  Fuxel  b = *f1Ptr ;
+  Q      marginA = Fuxel_margin( &a, isSpotlight ) ;
+  Q      marginB = Fuxel_margin( &b, isSpotlight ) ;
+
+  if ((marginA > Q_0) == (marginB > Q_0))
+    return false ;      //  Not a silhouette: leave it to halving.
+
+  const Q  tolerance = (Q_1 * LINE_PRECISION_PXL) / screenDistance ;    //  Bracket width small enough on screen.
+  Q        tA = Q_0 ;
+  Q        tB = Q_1 ;
+  int      kept = 0 ;                                                   //  Bracket end kept on the last step: -1 a, +1 b.
+
+  for (int n = 0  ;  n < TERMINATOR_SECANT_STEPS  &&  tB - tA > tolerance  ;  ++n)
   {
-    f0 = f1 ;
+    const Q  width = tB - tA ;
+    Q        t     = tA + Q_mul( width, Q_div( marginA, marginA - marginB ) ) ;
 
-    f1 = (Fuxel){ .world      =  (Q3){ .x = grid_major_x[i] << COORD_SHIFT
+    //  Keep off the bracket ends so it always shrinks.
+    if (t < tA + (width >> 4))  t = tA + (width >> 4) ;
+    if (t > tB - (width >> 4))  t = tB - (width >> 4) ;
+
+    Fuxel  probe ;
+    Fuxel_lerp( &probe, f0Ptr, f1Ptr, t ) ;
+
+    const Q  margin = Fuxel_margin( &probe, isSpotlight ) ;
+
+    if ((margin > Q_0) == (marginA > Q_0))
+    {
+      a = probe ;  tA = t ;  marginA = margin ;
+
+      if (kept == +1)  marginB -= marginB / 2 ;     //  Illinois: b kept twice in a row, pull the next step towards it.
+      kept = +1 ;
+    }
+    else
+    {
+      b = probe ;  tB = t ;  marginB = margin ;
+
+      if (kept == -1)  marginA -= marginA / 2 ;
+      kept = -1 ;
+    }
+  }
+
+  if (tB < Q_1)
+  {
+    Fuxel_terminator_set( &b, f0Ptr ) ;
+    draw_stack[(*depthPtr)++] = b ;
+  }
+
+  if (tA > Q_0)
+  {
+    Fuxel_terminator_set( &a, f0Ptr ) ;
+    draw_stack[(*depthPtr)++] = a ;
+  }
+
+  return (tA > Q_0  ||  tB < Q_1) ;
+}
+#endif
+
+
+#if defined(GIF)
+  #define DRAW_ZOOMIN   true      //  Always look for terminators, however alike the ends look.
+#else
+  #define DRAW_ZOOMIN   false
+#endif
+
+
+// One loop for every mode on purpose: per (detail, illumination) specialized copies were timed on the host harness, and
+// came out within run to run noise for about 1.7K more code.
+void
+function_draw_line
+(       GContext *gCtx
+, const Fuxel    *f0Ptr
+, const Fuxel    *f1Ptr
+)
+{
+  const bool  isFine = (s_detail == DETAIL_FINE) ;
+  Fuxel  from  = *f0Ptr ;     //  Left hand end of the segment being looked at, draw_stack's top is the right hand one.
+  int    depth = 0 ;
+
+  draw_stack[depth++] = *f1Ptr ;
+
+  while (depth > 0)
+  {
+    PROFILE_MAX( PROFILE_COUNTER_DRAW_DEPTH, depth ) ;
+    const Fuxel *toPtr = &draw_stack[depth-1] ;
+
+    if (from.visibility.cam || toPtr->visibility.cam)    //  One of the points is visible ?
+    {
+      if ( (DRAW_ZOOMIN || !Fuxel_visualyIdentical( &from, toPtr, isFine ))   //  Is there any cam/spotlight terminator to find ?
+        && depth < DRAW_STACK_SIZE - 1                          //  Room for a terminator bracket ?
+         )
+      {
+        // Calculate screen distance between from & to.
+        int sdx = from.screen.x - toPtr->screen.x  ;  if (sdx < 0) sdx = -sdx ;   // Abs delta screen x.
+        int sdy = from.screen.y - toPtr->screen.y  ;  if (sdy < 0) sdy = -sdy ;   // Abs delta screen y.
+
+        if ((sdx + sdy) > LINE_PRECISION_PXL)   // Screen distance still too far apart ?
+        {
+          #if defined(TERMINATOR_SECANT)
+            if (from.visibility.cam != toPtr->visibility.cam)
+            {
+              #if defined(OPAQUE_HORIZON)
+              if (s_transparency != TRANSPARENCY_OPAQUE)    //  Opaque cam visibility isn't ray marched: no margin.
+              #endif
+              {
+                if (function_terminator_push( &from, toPtr, false, sdx + sdy, &depth ))
+                  continue ;
+              }
+            }
+            #if !defined(SHADOW_MAP)
+              else if (s_illumination == ILLUMINATION_SPOTLIGHT  &&  from.visibility.cam  &&  from.visibility.spotlight != toPtr->visibility.spotlight)
+              {
+                if (function_terminator_push( &from, toPtr, true, sdx + sdy, &depth ))
+                  continue ;
+              }
+            #endif
+          #endif
+
+          // Need to zoom in on: look at from -> half first.
+          PROFILE_COUNT( PROFILE_COUNTER_SUBDIVISIONS, 1 ) ;
+          Fuxel  *halfPtr = &draw_stack[depth++] ;
+
+          halfPtr->world.x  = (from.world.x + toPtr->world.x) >> 1 ;
+          halfPtr->world.y  = (from.world.y + toPtr->world.y) >> 1 ;
+          halfPtr->dist2osc = oscillator_distance( halfPtr->world.x, halfPtr->world.y ) ;
+          halfPtr->world.z  = f_distance( halfPtr->dist2osc ) ;
+
+          #if defined(TERMINATOR_SECANT)
+            halfPtr->camMargin = halfPtr->spotlightMargin = Q_0 ;
+          #endif
+
+          #if defined(VISIBILITY_HINTS)
+            halfPtr->visibility = from.visibility ;   //  Neighbour's crossings make a good first guess.
+          #endif
+
+          #if defined(OPAQUE_HORIZON)
+            if (s_transparency == TRANSPARENCY_OPAQUE  &&  from.visibility.cam == toPtr->visibility.cam)
+            {
+              // No cam terminator to look for: the floating horizon already classified both ends alike.
+              halfPtr->visibility.cam = from.visibility.cam ;
+              Visibility_spotlight_set( &halfPtr->visibility, halfPtr->world ) ;
+            }
+            else
+          #endif
+              Visibility_set( &halfPtr->visibility, halfPtr->world ) ;
+          screen_project( &halfPtr->screen, halfPtr->world ) ;
+
+          #if defined(PBL_COLOR)
+            halfPtr->pen.color = Fuxel_color( halfPtr ) ;
+          #else
+            halfPtr->pen.ink   = Fuxel_ink( halfPtr ) ;
+          #endif
+
+          continue ;
+        }
+      }
+
+      // We reach this point because either there are no color terminators between from & to,
+      // or the screen distance is close enough to avoid needing to find them.
+      #if defined(FRAMEBUFFER_DRAW)
+        draw_fb_release( gCtx ) ;   //  Done with the dots: the GContext can't draw while the framebuffer is captured.
+      #endif
+
+      #if defined(PBL_COLOR)
+        graphics_context_set_stroke_color( gCtx, from.visibility.cam ? from.pen.color : toPtr->pen.color ) ;
+        graphics_draw_line( gCtx, from.screen, toPtr->screen ) ;
+      #else
+        Draw2D_line_pattern( gCtx
+                           , from.screen.x,   from.screen.y
+                           , toPtr->screen.x, toPtr->screen.y
+                           , from.visibility.cam ? from.pen.ink : toPtr->pen.ink
+                           ) ;
+      #endif
+    }
+
+    from = *toPtr ;     //  Done with from -> to: go on from there.
+    --depth ;
+  }
+}
+
+
+// x parallel line form function point (Fuxel) f0 to f1.
+void
+grid_major_drawLineX
+( GContext *gCtx
+, int       j
+)
+{
+  Fuxel f0, f1 ;
+  const Q grid_major_y_j = grid_major_y[j] << COORD_SHIFT ;
+
+  f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x[0] << COORD_SHIFT
+                                  , .y = grid_major_y_j
+                                  , .z = grid_major_z[0][j] << Z_SHIFT
+                                  }
+              , .dist2osc   = grid_major_dist2osc[0][j] << DIST_SHIFT
+              , .visibility = grid_major_visibility[0][j]
+              , .screen     = grid_major_screen[0][j]
+              }
+  ;
+
+  #if defined(PBL_COLOR)
+    f1.pen.color = grid_major_pen[0][j] ;
+  #else
+    f1.pen.ink   = (ink_t)grid_major_pen[0][j] ;
+  #endif
+
+  for (int i = 1  ;  i < GRID_LINES ;  ++i)
+  {
+    f0 = f1 ;
+
+    f1 = (Fuxel){ .world      =  (Q3){ .x = grid_major_x[i] << COORD_SHIFT
                                      , .y = grid_major_y_j
                                      , .z = grid_major_z[i][j] << Z_SHIFT
                                      }
@@ -1644,213 +3674,765 @@ grid_major_drawLineX
     ;
 
     #if defined(PBL_COLOR)
-      f1.pen.color = Fuxel_color( &f1 ) ;
+      f1.pen.color = grid_major_pen[i][j] ;
     #else
-      f1.pen.ink   = Fuxel_ink( &f1 ) ;
+      f1.pen.ink   = (ink_t)grid_major_pen[i][j] ;
     #endif
 
-    #if defined(GIF)
-      function_draw_line( gCtx, &f0, &f1, true ) ;
-    #else
-      function_draw_line( gCtx, &f0, &f1, false ) ;
-    #endif
-  }
+    function_draw_line( gCtx, &f0, &f1 ) ;
+  }
+}
+
+
+// y parallel line.
+void
+grid_major_drawLineY
+( GContext *gCtx
+, int       i
+)
+{
+  Fuxel f0, f1 ;
+  const Q grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+
+  f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x_i
+                                  , .y = grid_major_y[0] << COORD_SHIFT
+                                  , .z = grid_major_z[i][0] << Z_SHIFT
+                                  }
+              , .visibility = grid_major_visibility[i][0]
+              , .dist2osc   = grid_major_dist2osc[i][0] << DIST_SHIFT
+              , .screen     = grid_major_screen[i][0]
+              }
+  ;
+
+  #if defined(PBL_COLOR)
+    f1.pen.color = grid_major_pen[i][0] ;
+  #else
+    f1.pen.ink   = (ink_t)grid_major_pen[i][0] ;
+  #endif
+
+  for (int j = 1  ;  j < GRID_LINES ;  ++j)
+  {
+    f0 = f1 ;
+
+    f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x_i
+                                    , .y = grid_major_y[j] << COORD_SHIFT
+                                    , .z = grid_major_z[i][j] << Z_SHIFT
+                                    }
+                , .visibility = grid_major_visibility[i][j]
+                , .dist2osc   = grid_major_dist2osc[i][j] << DIST_SHIFT
+                , .screen     = grid_major_screen[i][j]
+                }
+    ;
+
+    #if defined(PBL_COLOR)
+      f1.pen.color = grid_major_pen[i][j] ;
+    #else
+      f1.pen.ink   = (ink_t)grid_major_pen[i][j] ;
+    #endif
+
+    function_draw_line( gCtx, &f0, &f1 ) ;
+  }
+}
+
+
+void
+grid_major_drawLinesX
+( GContext *gCtx )
+{
+  for (int l = 0  ;  l < GRID_LINES  ;  ++l)
+    grid_major_drawLineX( gCtx, l ) ;
+}
+
+
+void
+grid_major_drawLinesY
+( GContext *gCtx )
+{
+  for (int l = 0  ;  l < GRID_LINES  ;  ++l)
+    grid_major_drawLineY( gCtx, l ) ;
+}
+
+
+void
+grid_major_screen_project
+( )
+{
+  for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+  {
+    const Q grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+
+    #if defined(SCREEN_PROJECT_BATCH)
+      screen_project_row( grid_major_screen[i], grid_major_x_i, grid_major_y, grid_major_z[i], &screen_major_xTerm[i], screen_major_yTerm, GRID_LINES ) ;
+    #else
+      for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+        screen_project( &grid_major_screen[i][j]
+                      , (Q3){ .x = grid_major_x_i
+                            , .y = grid_major_y[j] << COORD_SHIFT
+                            , .z = grid_major_z[i][j] << Z_SHIFT
+                            }
+                      ) ;
+    #endif
+  }
+}
+
+
+void
+grid_minor_drawLineX
+( GContext *gCtx
+, int       j
+)
+{
+  Fuxel f0, f1 ;
+  const Q grid_minor_y_j = grid_minor_y[j] << COORD_SHIFT ;
+
+  f1 = (Fuxel){ .world      = (Q3){ .x = grid_minor_x[0] << COORD_SHIFT
+                                  , .y = grid_minor_y_j
+                                  , .z = grid_minor_z[0][j] << Z_SHIFT
+                                  }
+              , .dist2osc   = grid_minor_dist2osc[0][j] << DIST_SHIFT
+              , .visibility = grid_minor_visibility[0][j]
+              , .screen     = grid_minor_screen[0][j]
+              }
+  ;
+
+  #if defined(PBL_COLOR)
+    f1.pen.color = grid_minor_pen[0][j] ;
+  #else
+    f1.pen.ink   = (ink_t)grid_minor_pen[0][j] ;
+  #endif
+
+  for (int i = 1  ;  i < GRID_LINES-1 ;  ++i)
+  {
+    f0 = f1 ;
+    
+    f1 = (Fuxel){ .world      = (Q3){ .x = grid_minor_x[i] << COORD_SHIFT
+                                    , .y = grid_minor_y_j
+                                    , .z = grid_minor_z[i][j] << Z_SHIFT
+                                    }
+                , .dist2osc   = grid_minor_dist2osc[i][j] << DIST_SHIFT
+                , .visibility = grid_minor_visibility[i][j]
+                , .screen     = grid_minor_screen[i][j]
+                }
+    ;
+
+    #if defined(PBL_COLOR)
+      f1.pen.color = grid_minor_pen[i][j] ;
+    #else
+      f1.pen.ink   = (ink_t)grid_minor_pen[i][j] ;
+    #endif
+
+    function_draw_line( gCtx, &f0, &f1 ) ;
+  }
+}
+
+
+void
+grid_minor_drawLinesX
+( GContext *gCtx )
+{
+  for (int l = 0  ;  l < GRID_LINES-1  ;  ++l)
+    grid_minor_drawLineX( gCtx, l ) ;
+}
+
+
+void
+grid_minor_screen_project
+( )
+{
+  for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+  {
+    const Q grid_minor_x_i = grid_minor_x[i] << COORD_SHIFT ;
+
+    #if defined(SCREEN_PROJECT_BATCH)
+      screen_project_row( grid_minor_screen[i], grid_minor_x_i, grid_minor_y, grid_minor_z[i], &screen_minor_xTerm[i], screen_minor_yTerm, GRID_LINES-1 ) ;
+    #else
+      for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
+        screen_project( &grid_minor_screen[i][j]
+                      , (Q3){ .x = grid_minor_x_i
+                            , .y = grid_minor_y[j] << COORD_SHIFT
+                            , .z = grid_minor_z[i][j] << Z_SHIFT
+                            }
+                      ) ;
+    #endif
+  }
+}
+
+
+void
+grid_screen_project
+( )
+{
+  switch (s_pattern)
+  {
+    case PATTERN_UNDEFINED:
+    break ;
+
+    case PATTERN_DOTS:
+    case PATTERN_STRIPES:
+      grid_minor_screen_project( ) ;
+
+    case PATTERN_LINES:
+    case PATTERN_GRID:
+      grid_major_screen_project( ) ;
+    break ;
+  }
+
+  s_grid_screen_isCurrent = true ;
+}
+
+
+#if defined(OPAQUE_HORIZON)
+/***  ---------------  Floating horizon  ---------------  ***/
+
+// Screen space upper/lower envelopes of the grid rows already processed (front to back).
+static int16_t horizon_upper[PBL_DISPLAY_WIDTH] ;
+static int16_t horizon_lower[PBL_DISPLAY_WIDTH] ;
+
+
+void
+horizon_reset
+( )
+{
+  for (int x = 0  ;  x < PBL_DISPLAY_WIDTH  ;  ++x)
+  {
+    horizon_upper[x] = INT16_MAX ;
+    horizon_lower[x] = INT16_MIN ;
+  }
+}
+
+
+inline
+static
+bool
+horizon_isVisible
+( const GPoint screen )
+{
+  if (screen.x < 0  ||  screen.x >= PBL_DISPLAY_WIDTH)
+    return true ;
+
+  return screen.y <= horizon_upper[screen.x]  ||  screen.y >= horizon_lower[screen.x] ;
+}
+
+
+// Widen the envelopes with the screen segment from s0 to s1.
+void
+horizon_merge
+( GPoint s0
+, GPoint s1
+)
+{
+  if (s0.x > s1.x)
+  {
+    const GPoint swap = s0 ;  s0 = s1 ;  s1 = swap ;
+  }
+
+  const int  dx    = s1.x - s0.x ;
+  const int  xFrom = (s0.x < 0) ? 0 : s0.x ;
+  const int  xTo   = (s1.x >= PBL_DISPLAY_WIDTH) ? PBL_DISPLAY_WIDTH-1 : s1.x ;
+
+  if (dx == 0)
+  {
+    if (xFrom > xTo)
+      return ;
+
+    if (s0.y > s1.y)
+    {
+      const GPoint swap = s0 ;  s0 = s1 ;  s1 = swap ;
+    }
+
+    if (s0.y < horizon_upper[xFrom])  horizon_upper[xFrom] = s0.y ;
+    if (s1.y > horizon_lower[xFrom])  horizon_lower[xFrom] = s1.y ;
+    return ;
+  }
+
+  const int32_t slope = ((int32_t)(s1.y - s0.y) << 16) / dx ;   // S15.16 screen y increment per screen x.
+        int32_t y     = ((int32_t)s0.y << 16) + slope * (xFrom - s0.x) ;
+
+  for (int x = xFrom  ;  x <= xTo  ;  ++x, y += slope)
+  {
+    const int16_t yx = (y + (1 << 15)) >> 16 ;
+
+    if (yx < horizon_upper[x])  horizon_upper[x] = yx ;
+    if (yx > horizon_lower[x])  horizon_lower[x] = yx ;
+  }
+}
+
+
+// Classic floating horizon hidden point removal: sweeps the grid rows front to back relative to the cam view point,
+// a vertex is visible if it projects outside the envelopes of the rows in front of it.
+void
+grid_horizon_visibility_update
+( )
+{
+  #if defined(VISIBILITY_CACHE)
+    visibility_cache_select( ) ;
+  #endif
+
+  if (!s_grid_screen_isCurrent)
+    grid_screen_project( ) ;
+
+  horizon_reset( ) ;
+
+  const bool hasMinor  = (s_pattern == PATTERN_DOTS  ||  s_pattern == PATTERN_STRIPES) ;
+  const Q    vpX       = s_cam.viewPoint.x ;
+  const Q    vpY       = s_cam.viewPoint.y ;
+  const bool alongY    = ((vpY < 0) ? -vpY : vpY) >= ((vpX < 0) ? -vpX : vpX) ;   // Rows of constant j swept along y, else rows of constant i swept along x.
+  const bool ascending = alongY ? (vpY < Q_0) : (vpX < Q_0) ;                      // Viewer is on the low index side.
+
+  for (int r = 0  ;  r < GRID_LINES  ;  ++r)
+  {
+    const int row = ascending ? r : GRID_LINES-1 - r ;
+    const int prv = ascending ? row-1 : row+1 ;        // Row in front, already merged.
+
+    // 1) Merge the links from the row in front: the surface patches between both rows occlude this one too.
+    if (prv >= 0  &&  prv < GRID_LINES)
+      for (int k = 0  ;  k < GRID_LINES  ;  ++k)
+        horizon_merge( alongY ? grid_major_screen[k][prv] : grid_major_screen[prv][k]
+                     , alongY ? grid_major_screen[k][row] : grid_major_screen[row][k]
+                     ) ;
+
+    // 2) Classify the major row against the envelopes of everything in front of it.
+    for (int k = 0  ;  k < GRID_LINES  ;  ++k)
+    {
+      const int i = alongY ? k : row ;
+      const int j = alongY ? row : k ;
+
+      Visibility *visibilityPtr = &grid_major_visibility[i][j] ;
+
+      visibilityPtr->cam = horizon_isVisible( grid_major_screen[i][j] ) ;
+      Visibility_spotlight_set( visibilityPtr
+                              , (Q3){ .x = grid_major_x[i] << COORD_SHIFT
+                                    , .y = grid_major_y[j] << COORD_SHIFT
+                                    , .z = grid_major_z[i][j] << Z_SHIFT
+                                    }
+                              ) ;
+    }
+
+    // 3) Merge the row itself.
+    for (int k = 1  ;  k < GRID_LINES  ;  ++k)
+      horizon_merge( alongY ? grid_major_screen[k-1][row] : grid_major_screen[row][k-1]
+                   , alongY ? grid_major_screen[k  ][row] : grid_major_screen[row][k  ]
+                   ) ;
+
+    // 4) Classify the minor row just behind this major row.
+    const int minorRow = ascending ? row : row-1 ;
+
+    if (hasMinor  &&  minorRow >= 0  &&  minorRow < GRID_LINES-1)
+      for (int k = 0  ;  k < GRID_LINES-1  ;  ++k)
+      {
+        const int i = alongY ? k : minorRow ;
+        const int j = alongY ? minorRow : k ;
+
+        Visibility *visibilityPtr = &grid_minor_visibility[i][j] ;
+
+        visibilityPtr->cam = horizon_isVisible( grid_minor_screen[i][j] ) ;
+        Visibility_spotlight_set( visibilityPtr
+                                , (Q3){ .x = grid_minor_x[i] << COORD_SHIFT
+                                      , .y = grid_minor_y[j] << COORD_SHIFT
+                                      , .z = grid_minor_z[i][j] << Z_SHIFT
+                                      }
+                                ) ;
+      }
+  }
+}
+#endif
+
+
+void
+grid_draw
+( GContext *gCtx )
+{
+  // Draw the calculated screen points.
+  switch (s_pattern)
+  {
+    case PATTERN_UNDEFINED:
+    break ;
+
+    case PATTERN_DOTS:
+      if (s_transparency == TRANSPARENCY_XRAY)
+      {
+        grid_major_drawPixel_XRAY( gCtx ) ;
+        grid_minor_drawPixel_XRAY( gCtx ) ;
+      }
+
+      grid_major_drawPixel( gCtx ) ;
+      grid_minor_drawPixel( gCtx ) ;
+
+      // Grid frame.
+      grid_major_drawLineX( gCtx, 0            ) ;
+      grid_major_drawLineX( gCtx, GRID_LINES-1 ) ;
+      grid_major_drawLineY( gCtx, 0            ) ;
+      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
+    break ;
+
+    case PATTERN_LINES:
+      if (s_transparency == TRANSPARENCY_XRAY)
+        grid_major_drawPixel_XRAY( gCtx ) ;
+
+      grid_major_drawLinesX( gCtx ) ;
+
+      // Grid frame.
+      grid_major_drawLineY( gCtx, 0            ) ;
+      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
+    break ;
+
+    case PATTERN_STRIPES:
+      if (s_transparency == TRANSPARENCY_XRAY)
+      {
+        grid_major_drawPixel_XRAY( gCtx ) ;
+        grid_minor_drawPixel_XRAY( gCtx ) ;
+      }
+
+      grid_major_drawLinesX( gCtx ) ;
+      grid_minor_drawLinesX( gCtx ) ;
+
+      // Grid frame.
+      grid_major_drawLineY( gCtx, 0            ) ;
+      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
+    break ;
+
+    case PATTERN_GRID:
+      if (s_transparency == TRANSPARENCY_XRAY)
+        grid_major_drawPixel_XRAY( gCtx ) ;
+
+      grid_major_drawLinesX( gCtx ) ;
+      grid_major_drawLinesY( gCtx ) ;
+    break ;
+  }
+}
+
+
+#if defined(BENCHMARK)
+/***  ---------------  Benchmark  ---------------  ***/
+
+#define BENCHMARK_CASES   (3 * 4 * 3 * 2 * 2)   //  Oscillator x Pattern x Transparency x Illumination x Detail
+
+static int       s_benchmark_case     = 0 ;
+static int       s_benchmark_frame    = 0 ;
+static uint32_t     s_benchmark_updateTime = 0 ;   // Duration of the last world_update( ), PROFILE_UNIT.
+static ProfileTime  s_benchmark_frameTime[BENCHMARK_FRAMES] ;
+static uint32_t  s_benchmark_fbHash    = 2166136261u ;   // FNV-1a of the case's drawn frames.
+static uint32_t  s_benchmark_fbHashAll = 2166136261u ;   // FNV-1a of the case fingerprints.
+
+
+void
+benchmark_case_set
+( int benchCase )
+{
+  const Detail        detail       = (Detail)      (DETAIL_COARSE            + benchCase % 2) ;  benchCase /= 2 ;
+  const Illumination  illumination = (Illumination)(ILLUMINATION_DIFUSE      + benchCase % 2) ;  benchCase /= 2 ;
+  const Transparency  transparency = (Transparency)(TRANSPARENCY_TRANSLUCENT + benchCase % 3) ;  benchCase /= 3 ;
+  const Pattern       pattern      = (Pattern)     (PATTERN_DOTS             + benchCase % 4) ;  benchCase /= 4 ;
+  const Oscillator    oscillator   = (Oscillator)  (OSCILLATOR_ANCHORED      + benchCase % 3) ;
+
+  // Oscillator first: OSCILLATOR_BOUNCING imposes its own pattern/transparency/illumination.
+  oscillator_set  ( oscillator   ) ;
+  pattern_set     ( pattern      ) ;
+  transparency_set( transparency ) ;
+  illumination_set( illumination ) ;
+  detail_set      ( detail       ) ;
+  cam_initialize( ) ;
+
+  // Every case replays the same phase sequence.
+  s_world_updateCount = 0 ;
+  s_benchmark_frame   = 0 ;
+}
+
+
+void
+benchmark_start
+( )
+{
+  LOGI( "benchmark:: GRID_LINES = %d, screen = %dx%d, %d cases x %d frames"
+      , GRID_LINES
+      , (int)Q_to_int(screen_project_translate.x << 1), (int)Q_to_int(screen_project_translate.y << 1)
+      , BENCHMARK_CASES, BENCHMARK_FRAMES
+      ) ;
+
+  benchmark_case_set( s_benchmark_case = 0 ) ;
 }
 
 
-// y parallel line.
+bool
+benchmark_isFinished
+( )
+{ return s_benchmark_case >= BENCHMARK_CASES ; }
+
+
+#if defined(DIST_TABLE)
+static int32_t  s_benchmark_distErrMax   = 0 ;   // Worst |dist_fromSquare( ) - Q_sqrt( )| in U4.12 LSBs.
+static uint32_t s_benchmark_distErrCount = 0 ;   // Distances more than 1 LSB off.
+
+// Checks dist_fromSquare( ) against Q_sqrt( ) over the lines x lines vertices of a grid, for the current oscillator position.
 void
-grid_major_drawLineY
-( GContext *gCtx
-, int       i
+benchmark_dist_validate
+( const int16_t *x
+, const int16_t *y
+, const int      lines
 )
 {
-  Fuxel f0, f1 ;
-  const Q grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+  for (int i = 0  ;  i < lines  ;  ++i)
+    for (int j = 0  ;  j < lines  ;  ++j)
+    {
+      const Q  dx     = oscillator_position.x - (x[i] << COORD_SHIFT) ;
+      const Q  dy     = oscillator_position.y - (y[j] << COORD_SHIFT) ;
+      const Q  square = Q_mul( dx, dx ) + Q_mul( dy, dy ) ;
+      int32_t  err    = (Q_sqrt( square ) >> DIST_SHIFT) - dist_fromSquare( square ) ;  if (err < 0) err = -err ;
 
-  f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x_i
-                                  , .y = grid_major_y[0] << COORD_SHIFT
-                                  , .z = grid_major_z[i][0] << Z_SHIFT
-                                  }
-              , .visibility = grid_major_visibility[i][0]
-              , .dist2osc   = grid_major_dist2osc[i][0] << DIST_SHIFT
-              , .screen     = grid_major_screen[i][0]
-              }
-  ;
+      if (err > s_benchmark_distErrMax)  s_benchmark_distErrMax = err ;
+      if (err > 1)                       ++s_benchmark_distErrCount ;
+    }
+}
+#endif
 
-  #if defined(PBL_COLOR)
-    f1.pen.color = Fuxel_color( &f1 ) ;
-  #else
-    f1.pen.ink   = Fuxel_ink( &f1 ) ;
-  #endif
 
-  for (int j = 1  ;  j < GRID_LINES ;  ++j)
-  {
-    f0 = f1 ;
+#if defined(VISIBILITY_INTERPOLATED)
+static Q        s_benchmark_probeErrMax   = 0 ;   // Worst |f_XY_interpolated( ) - f_XY( )|.
+static uint32_t s_benchmark_probeErrTotal = 0 ;   // Sum of |f_XY_interpolated( ) - f_XY( )| in S0.7 units, for the mean.
+static uint32_t s_benchmark_probeCount    = 0 ;
 
-    f1 = (Fuxel){ .world      = (Q3){ .x = grid_major_x_i
-                                    , .y = grid_major_y[j] << COORD_SHIFT
-                                    , .z = grid_major_z[i][j] << Z_SHIFT
-                                    }
-                , .visibility = grid_major_visibility[i][j]
-                , .dist2osc   = grid_major_dist2osc[i][j] << DIST_SHIFT
-                , .screen     = grid_major_screen[i][j]
-                }
-    ;
+// Checks f_XY_interpolated( ) against f_XY( ) on a half step lattice (vertices, edge middles & cell centers) of the current
+// grid_major_z.
+void
+benchmark_probe_validate
+( )
+{
+  const Q  halfStep = Q_div( grid_scale, Q_from_int(2 * (GRID_LINES - 1)) ) ;
 
-    #if defined(PBL_COLOR)
-      f1.pen.color = Fuxel_color( &f1 ) ;
-    #else
-      f1.pen.ink   = Fuxel_ink( &f1 ) ;
-    #endif
+  for (int i = 0  ;  i <= 2 * (GRID_LINES - 1)  ;  ++i)
+    for (int j = 0  ;  j <= 2 * (GRID_LINES - 1)  ;  ++j)
+    {
+      const Q  x   = world_xMin + i * halfStep ;
+      const Q  y   = world_yMin + j * halfStep ;
+      const Q  err = abs( f_XY_interpolated( x, y ) - f_XY( x, y ) ) ;
 
-    #if defined(GIF)
-      function_draw_line( gCtx, &f0, &f1, true ) ;
-    #else
-      function_draw_line( gCtx, &f0, &f1, false ) ;
-    #endif
-  }
+      if (err > s_benchmark_probeErrMax)  s_benchmark_probeErrMax = err ;
+      s_benchmark_probeErrTotal += err >> Z_SHIFT ;
+      ++s_benchmark_probeCount ;
+    }
 }
+#endif
 
 
+#if defined(SCREEN_PROJECT_BATCH)
+static uint32_t s_benchmark_projectCount    = 0 ;   // Vertices checked.
+static uint32_t s_benchmark_projectMismatch = 0 ;   // Of those, the ones screen_project_row( ) put off screen_project( )'s GPoint.
+static int      s_benchmark_projectErrMax   = 0 ;   // Worst distance to screen_project( )'s GPoint, in pixels (max of |dx|, |dy|).
+
+// Checks the lines x lines screen table, as projected by screen_project_row( ), against screen_project( ) of its vertices.
 void
-grid_major_drawLinesX
-( GContext *gCtx )
+benchmark_project_validate
+( const GPoint  *screen
+, const int16_t *x
+, const int16_t *y
+, const int8_t  *z
+, const int      lines
+)
 {
-  for (int l = 0  ;  l < GRID_LINES  ;  ++l)
-    grid_major_drawLineX( gCtx, l ) ;
+  for (int i = 0  ;  i < lines  ;  ++i)
+    for (int j = 0  ;  j < lines  ;  ++j)
+    {
+      GPoint  reference ;
+      screen_project( &reference, (Q3){ .x = x[i] << COORD_SHIFT, .y = y[j] << COORD_SHIFT, .z = z[i * lines + j] << Z_SHIFT } ) ;
+
+      const int  errX = abs( reference.x - screen[i * lines + j].x ) ;
+      const int  errY = abs( reference.y - screen[i * lines + j].y ) ;
+      const int  err  = (errX > errY) ? errX : errY ;
+
+      ++s_benchmark_projectCount ;
+      if (err > 0)                          ++s_benchmark_projectMismatch ;
+      if (err > s_benchmark_projectErrMax)  s_benchmark_projectErrMax = err ;
+    }
 }
+#endif
+
 
+#if defined(OPAQUE_HORIZON)
+static uint32_t s_benchmark_horizonCount = 0 ;   // Major vertices checked, over every TRANSPARENCY_OPAQUE case.
+static uint32_t s_benchmark_horizonAgree = 0 ;   // Of those, the ones the floating horizon got the ray march's cam visibility.
 
+// Checks the floating horizon's cam visibility of the major vertices against a plain ray march (no hints, no occluder).
 void
-grid_major_drawLinesY
-( GContext *gCtx )
+benchmark_horizon_validate
+( )
 {
-  for (int l = 0  ;  l < GRID_LINES  ;  ++l)
-    grid_major_drawLineY( gCtx, l ) ;
+  for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+    for (int j = 0  ;  j < GRID_LINES  ;  ++j)
+    {
+      const Q3  world = { .x = grid_major_x[i] << COORD_SHIFT, .y = grid_major_y[j] << COORD_SHIFT, .z = grid_major_z[i][j] << Z_SHIFT } ;
+      Q         crossingK ;
+
+      ++s_benchmark_horizonCount ;
+      if (grid_major_visibility[i][j].cam == function_isVisible_fromPoint( world, s_cam.viewPoint, s_cam_viewPoint_boxing, Q_0, &crossingK, NULL ))
+        ++s_benchmark_horizonAgree ;
+    }
 }
+#endif
 
 
 void
-grid_major_screen_project
+benchmark_case_report
 ( )
 {
-  for (int i = 0  ;  i < GRID_LINES  ;  ++i)
+  // Sort frame durations for the percentiles (insertion sort, BENCHMARK_FRAMES is small).
+  uint64_t total = 0 ;
+
+  for (int i = 0  ;  i < BENCHMARK_FRAMES  ;  ++i)
   {
-    const Q grid_major_x_i = grid_major_x[i] << COORD_SHIFT ;
+    const ProfileTime time = s_benchmark_frameTime[i] ;
+    int j ;
 
-    for (int j = 0  ;  j < GRID_LINES  ;  ++j)
-      screen_project( &grid_major_screen[i][j]
-                    , (Q3){ .x = grid_major_x_i
-                          , .y = grid_major_y[j] << COORD_SHIFT
-                          , .z = grid_major_z[i][j] << Z_SHIFT
-                          }
-                    ) ;
+    for (j = i  ;  j > 0  &&  s_benchmark_frameTime[j-1] > time  ;  --j)
+      s_benchmark_frameTime[j] = s_benchmark_frameTime[j-1] ;
+
+    s_benchmark_frameTime[j] = time ;
+    total += time ;
   }
-}
 
+  LOGI( "benchmark:: osc %d pat %d trn %d ill %d det %d : mean %lu.%02lu " PROFILE_UNIT "/frame, p50 %lu p90 %lu p99 %lu max %lu " PROFILE_UNIT ", fb %08lx"
+      , s_oscillator, s_pattern, s_transparency, s_illumination, s_detail
+      , (unsigned long)(total / BENCHMARK_FRAMES), (unsigned long)(total * 100 / BENCHMARK_FRAMES % 100)
+      , (unsigned long)s_benchmark_frameTime[BENCHMARK_FRAMES *  50 / 100]
+      , (unsigned long)s_benchmark_frameTime[BENCHMARK_FRAMES *  90 / 100]
+      , (unsigned long)s_benchmark_frameTime[BENCHMARK_FRAMES *  99 / 100]
+      , (unsigned long)s_benchmark_frameTime[BENCHMARK_FRAMES - 1]
+      , (unsigned long)s_benchmark_fbHash
+      ) ;
+
+  for (int b = 0  ;  b < 4  ;  ++b)
+  {
+    s_benchmark_fbHashAll ^= (uint8_t)(s_benchmark_fbHash >> (8 * b)) ;
+    s_benchmark_fbHashAll *= 16777619u ;
+  }
 
-void
-grid_minor_drawLineX
-( GContext *gCtx
-, int       j
-)
-{
-  Fuxel f0, f1 ;
-  const Q grid_minor_y_j = grid_minor_y[j] << COORD_SHIFT ;
+  s_benchmark_fbHash = 2166136261u ;
 
-  f1 = (Fuxel){ .world      = (Q3){ .x = grid_minor_x[0] << COORD_SHIFT
-                                  , .y = grid_minor_y_j
-                                  , .z = grid_minor_z[0][j] << Z_SHIFT
-                                  }
-              , .dist2osc   = grid_minor_dist2osc[0][j] << DIST_SHIFT
-              , .visibility = grid_minor_visibility[0][j]
-              , .screen     = grid_minor_screen[0][j]
-              }
-  ;
+  #if defined(DIST_TABLE)
+    // Untimed: once per case, over both grids as the case's last frame left the oscillator.
+    benchmark_dist_validate( grid_major_x, grid_major_y, GRID_LINES   ) ;
+    benchmark_dist_validate( grid_minor_x, grid_minor_y, GRID_LINES-1 ) ;
 
-  #if defined(PBL_COLOR)
-    f1.pen.color = Fuxel_color( &f1 ) ;
-  #else
-    f1.pen.ink   = Fuxel_ink( &f1 ) ;
+    LOGI( "benchmark:: dist_fromSquare max error %ld LSB, %lu off by more than 1 LSB"
+        , (long)s_benchmark_distErrMax, (unsigned long)s_benchmark_distErrCount
+        ) ;
+
+    s_benchmark_distErrMax   = 0 ;
+    s_benchmark_distErrCount = 0 ;
   #endif
 
-  for (int i = 1  ;  i < GRID_LINES-1 ;  ++i)
-  {
-    f0 = f1 ;
-    
-    f1 = (Fuxel){ .world      = (Q3){ .x = grid_minor_x[i] << COORD_SHIFT
-                                    , .y = grid_minor_y_j
-                                    , .z = grid_minor_z[i][j] << Z_SHIFT
-                                    }
-                , .dist2osc   = grid_minor_dist2osc[i][j] << DIST_SHIFT
-                , .visibility = grid_minor_visibility[i][j]
-                , .screen     = grid_minor_screen[i][j]
-                }
-    ;
+  #if defined(SCREEN_PROJECT_BATCH)
+    // Untimed: once per case, on the screen tables of the case's last frame.
+    benchmark_project_validate( &grid_major_screen[0][0], grid_major_x, grid_major_y, &grid_major_z[0][0], GRID_LINES   ) ;
+    benchmark_project_validate( &grid_minor_screen[0][0], grid_minor_x, grid_minor_y, &grid_minor_z[0][0], GRID_LINES-1 ) ;
 
-    #if defined(PBL_COLOR)
-      f1.pen.color = Fuxel_color( &f1 ) ;
-    #else
-      f1.pen.ink   = Fuxel_ink( &f1 ) ;
-    #endif
+    LOGI( "benchmark:: screen_project_row %lu of %lu vertices off screen_project( ), by up to %d px"
+        , (unsigned long)s_benchmark_projectMismatch, (unsigned long)s_benchmark_projectCount, s_benchmark_projectErrMax
+        ) ;
 
-    #if defined(GIF)
-      function_draw_line( gCtx, &f0, &f1, true ) ;
-    #else
-      function_draw_line( gCtx, &f0, &f1, false ) ;
-    #endif
-  }
+    s_benchmark_projectCount    = 0 ;
+    s_benchmark_projectMismatch = 0 ;
+    s_benchmark_projectErrMax   = 0 ;
+  #endif
+
+  #if defined(OPAQUE_HORIZON)
+    if (s_transparency == TRANSPARENCY_OPAQUE)
+      benchmark_horizon_validate( ) ;   // Untimed: once per case, on the case's last frame. Reported when done.
+  #endif
+
+  #if defined(VISIBILITY_INTERPOLATED)
+    benchmark_probe_validate( ) ;   // Untimed: once per case, on the case's last z lattice.
+
+    LOGI( "benchmark:: f_XY_interpolated max error %ld/128, mean %lu/1000 of 1/128 over %lu samples"
+        , (long)(s_benchmark_probeErrMax >> Z_SHIFT)
+        , (unsigned long)(s_benchmark_probeCount ? (uint64_t)s_benchmark_probeErrTotal * 1000 / s_benchmark_probeCount : 0)
+        , (unsigned long)s_benchmark_probeCount
+        ) ;
+
+    s_benchmark_probeErrMax   = 0 ;
+    s_benchmark_probeErrTotal = 0 ;
+    s_benchmark_probeCount    = 0 ;
+  #endif
 }
 
 
+// Folds the drawn framebuffer into the case fingerprint. Untimed: called once the frame's duration is taken.
 void
-grid_minor_drawLinesX
+benchmark_framebuffer_hash
 ( GContext *gCtx )
 {
-  for (int l = 0  ;  l < GRID_LINES-1  ;  ++l)
-    grid_minor_drawLineX( gCtx, l ) ;
-}
+  if (benchmark_isFinished( ))
+    return ;
 
+  GBitmap *fb = graphics_capture_frame_buffer( gCtx ) ;
 
-void
-grid_minor_screen_project
-( )
-{
-  for (int i = 0  ;  i < GRID_LINES-1  ;  ++i)
+  if (fb == NULL)
+    return ;
+
+  const GRect  bounds = gbitmap_get_bounds( fb ) ;
+
+  for (int y = 0  ;  y < bounds.size.h  ;  ++y)
   {
-    const Q grid_minor_x_i = grid_minor_x[i] << COORD_SHIFT ;
+    #if defined(PBL_ROUND)
+      const GBitmapDataRowInfo  rowInfo = gbitmap_get_data_row_info( fb, y ) ;
+      const uint8_t            *row     = rowInfo.data + rowInfo.min_x ;
+      const int                 bytes   = rowInfo.max_x - rowInfo.min_x + 1 ;
+    #else
+      const uint8_t            *row     = gbitmap_get_data( fb ) + y * gbitmap_get_bytes_per_row( fb ) ;
+      #if defined(PBL_COLOR)
+        const int               bytes   = bounds.size.w ;
+      #else
+        const int               bytes   = (bounds.size.w + 7) >> 3 ;   // 1 bit: leave the row padding out.
+      #endif
+    #endif
 
-    for (int j = 0  ;  j < GRID_LINES-1  ;  ++j)
-      screen_project( &grid_minor_screen[i][j]
-                    , (Q3){ .x = grid_minor_x_i
-                          , .y = grid_minor_y[j] << COORD_SHIFT
-                          , .z = grid_minor_z[i][j] << Z_SHIFT
-                          }
-                    ) ;
+    for (int b = 0  ;  b < bytes  ;  ++b)
+    {
+      s_benchmark_fbHash ^= row[b] ;
+      s_benchmark_fbHash *= 16777619u ;
+    }
   }
+
+  graphics_release_frame_buffer( gCtx, fb ) ;
 }
 
 
 void
-grid_screen_project
-( )
+benchmark_frame_record
+( const uint32_t drawTime )
 {
-  switch (s_pattern)
-  {
-    case PATTERN_UNDEFINED:
-    break ;
+  if (benchmark_isFinished( ))
+    return ;
 
-    case PATTERN_DOTS:
-    case PATTERN_STRIPES:
-      grid_minor_screen_project( ) ;
+  s_user_secondsInactive = 0 ;   // Keep the auto-exit away while benchmarking.
 
-    case PATTERN_LINES:
-    case PATTERN_GRID:
-      grid_major_screen_project( ) ;
-    break ;
+  const uint32_t frameTime = (drawTime > UINT32_MAX - s_benchmark_updateTime) ? UINT32_MAX : s_benchmark_updateTime + drawTime ;
+  s_benchmark_frameTime[s_benchmark_frame] = (frameTime > PROFILE_TIME_MAX) ? PROFILE_TIME_MAX : frameTime ;
+
+  #if defined(HOST)
+    host_frame_record( frameTime ) ;
+  #endif
+
+  if (++s_benchmark_frame < BENCHMARK_FRAMES)
+    return ;
+
+  benchmark_case_report( ) ;
+
+  if (++s_benchmark_case < BENCHMARK_CASES)
+    benchmark_case_set( s_benchmark_case ) ;
+  else
+  {
+    #if defined(OPAQUE_HORIZON)
+      LOGI( "benchmark:: horizon agreement %lu.%lu%% of %lu major vertices"
+          , (unsigned long)((uint64_t)s_benchmark_horizonAgree * 100  / s_benchmark_horizonCount)
+          , (unsigned long)((uint64_t)s_benchmark_horizonAgree * 1000 / s_benchmark_horizonCount % 10)
+          , (unsigned long)s_benchmark_horizonCount
+          ) ;
+    #endif
+
+    LOGI( "benchmark:: done, fb %08lx", (unsigned long)s_benchmark_fbHashAll ) ;
   }
 }
+#endif
 
 
 void
@@ -1863,6 +4445,10 @@ world_draw
   LOGD( "world_draw:: s_world_updateCount = %d", s_world_updateCount ) ;
 #endif
 
+#if defined(BENCHMARK)
+  const uint32_t drawStart = profile_now( ) ;
+#endif
+
 #if defined(PBL_COLOR)
   switch (s_detail)
   {
@@ -1881,65 +4467,31 @@ world_draw
   graphics_context_set_stroke_color( gCtx, s_color_stroke ) ;
 #endif
 
-  grid_screen_project( ) ;
-
-  // Draw the calculated screen points.
-  switch (s_pattern)
-  {
-    case PATTERN_UNDEFINED:
-    break ;
-
-    case PATTERN_DOTS:
-      if (s_transparency == TRANSPARENCY_XRAY)
-      {
-        grid_major_drawPixel_XRAY( gCtx ) ;
-        grid_minor_drawPixel_XRAY( gCtx ) ;
-      }
-
-      grid_major_drawPixel( gCtx ) ;
-      grid_minor_drawPixel( gCtx ) ;
-
-      // Grid frame.
-      grid_major_drawLineX( gCtx, 0            ) ;
-      grid_major_drawLineX( gCtx, GRID_LINES-1 ) ;
-      grid_major_drawLineY( gCtx, 0            ) ;
-      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
-    break ;
-
-    case PATTERN_LINES:
-      if (s_transparency == TRANSPARENCY_XRAY)
-        grid_major_drawPixel_XRAY( gCtx ) ;
-
-      grid_major_drawLinesX( gCtx ) ;
+  if (!s_grid_screen_isCurrent)
+    PROFILE_STAGE( PROFILE_STAGE_PROJECT, grid_screen_project( ) ) ;
+  if (!s_grid_pen_isCurrent)
+    PROFILE_STAGE( PROFILE_STAGE_DRAW,    grid_pen_update( )     ) ;
 
-      // Grid frame.
-      grid_major_drawLineY( gCtx, 0            ) ;
-      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
-    break ;
+#if defined(FRAMEBUFFER_DRAW)
+  if (s_pattern == PATTERN_DOTS  ||  s_transparency == TRANSPARENCY_XRAY)    //  Only those have dot passes.
+    draw_fb_capture( gCtx ) ;
+#endif
 
-    case PATTERN_STRIPES:
-      if (s_transparency == TRANSPARENCY_XRAY)
-      {
-        grid_major_drawPixel_XRAY( gCtx ) ;
-        grid_minor_drawPixel_XRAY( gCtx ) ;
-      }
+  PROFILE_STAGE( PROFILE_STAGE_DRAW,    grid_draw( gCtx )       ) ;
 
-      grid_major_drawLinesX( gCtx ) ;
-      grid_minor_drawLinesX( gCtx ) ;
+#if defined(FRAMEBUFFER_DRAW)
+  draw_fb_release( gCtx ) ;
+#endif
 
-      // Grid frame.
-      grid_major_drawLineY( gCtx, 0            ) ;
-      grid_major_drawLineY( gCtx, GRID_LINES-1 ) ;
-    break ;
+#if defined(BENCHMARK)
+  const uint32_t drawTime = profile_now( ) - drawStart ;
 
-    case PATTERN_GRID:
-      if (s_transparency == TRANSPARENCY_XRAY)
-        grid_major_drawPixel_XRAY( gCtx ) ;
+  // Untimed.
+  benchmark_framebuffer_hash( gCtx ) ;
+  benchmark_frame_record( drawTime ) ;
+#endif
 
-      grid_major_drawLinesX( gCtx ) ;
-      grid_major_drawLinesY( gCtx ) ;
-    break ;
-  }
+  PROFILE_FRAME_END( ) ;
 }
 
 
@@ -1971,6 +4523,14 @@ world_finalize
 #if !defined(GIF)
   accelSamplers_finalize( ) ;
 #endif
+
+#if defined(ANCHORED_CACHE)
+  anchored_cache_finalize( ) ;
+#endif
+
+#if defined(VISIBILITY_CACHE)
+  visibility_cache_finalize( ) ;
+#endif
 }
 
 
@@ -1979,7 +4539,17 @@ world_update_timer_handler
 ( void *data )
 {
   s_world_updateTimer_ptr = NULL ;
+
+#if defined(BENCHMARK)
+  if (benchmark_isFinished( ))
+    return ;
+
+  const uint32_t updateStart = profile_now( ) ;
+  world_update( ) ;
+  s_benchmark_updateTime = profile_now( ) - updateStart ;
+#else
   world_update( ) ;
+#endif
 
 #if defined(GIF)
   if (s_world_updateCount < GIF_STOP_COUNT)
@@ -2018,6 +4588,10 @@ world_start
     tick_timer_service_subscribe( SECOND_UNIT, tick_timer_service_handler ) ;    
   #endif
 
+  #if defined(BENCHMARK)
+    benchmark_start( ) ;
+  #endif
+
   // Start animation.
   world_update_timer_handler( NULL ) ;
 }
@@ -2088,6 +4662,10 @@ window_load
   screen_project_translate.x = Q_from_int(screen_availableSize.w) >> 1 ;
   screen_project_translate.y = Q_from_int(screen_availableSize.h) >> 1 ;
 
+  #if defined(SCREEN_PROJECT_BATCH)
+    screen_projection_update( ) ;
+  #endif
+
   s_action_bar_layer = action_bar_layer_create( ) ;
   action_bar_layer_set_background_color     ( s_action_bar_layer, s_color_background    ) ;
   action_bar_layer_set_click_config_provider( s_action_bar_layer, click_config_provider ) ;
@@ -74,6 +74,61 @@
 #define  LIGHT_DISTANCEFROMORIGIN   5.25f
 
 
+/* -----------   VISIBILITY PARAMETERS   ----------- */
+
+// Uncommenting the next line will use a screen space floating horizon, instead of ray marching, for TRANSPARENCY_OPAQUE camera visibility.
+// Approximate: over the BENCHMARK's opaque cases it gives the ray march's cam visibility on 89.7% (APLITE), 90.8% (BASALT,
+// DIORITE), 90.9% (EMERY) and 93.2% (CHALK) of the major vertices. host/run.sh fails if that drops.
+//#define  OPAQUE_HORIZON
+
+// Uncommenting the next line will march view rays by Lipschitz bounded safe steps (|altitude| / max slope),
+// instead of sampling them at fixed halving steps.
+//#define  VISIBILITY_SPHERE_TRACING
+
+// Uncommenting the next line will have view ray probes interpolate z bilinearly from the grid_major_z lattice,
+// instead of evaluating f(x,y): cheaper, but visibility is only as accurate as the lattice.
+//#define  VISIBILITY_INTERPOLATED
+
+// Uncommenting the next line will test ILLUMINATION_SPOTLIGHT visibility against a per frame light space height map,
+// instead of marching a ray to the spotlight.
+//#define  SHADOW_MAP
+
+// Uncommenting the next line will keep, per vertex, where last frame's rays crossed the surface and retry that spot first:
+// a hidden vertex usually stays hidden by the same occluder from one frame to the next.
+//#define  VISIBILITY_HINTS
+
+// Uncommenting the next line will ray march grid visibility on every 4th line first, then only refine (halving the stride)
+// the blocks whose corners disagree. Must be a power of 2.
+//#define  VISIBILITY_COARSE_STRIDE   4
+
+// Uncommenting the next line will first test a hidden vertex's grid line neighbour's occluder (where its ray crossed the surface)
+// before ray marching the whole view line.
+//#define  VISIBILITY_OCCLUDER_CACHE
+
+// Uncommenting the next line will settle vertices whose (analytic) surface normal faces away from the cam/spotlight as hidden,
+// without ray marching them.
+//#define  VISIBILITY_BACKFACE
+
+// Uncommenting the next line will locate silhouette cam/spotlight terminators along drawn lines by regula falsi steps on the
+// near field occlusion margin (how fast the view line clears the surface), instead of halving until LINE_PRECISION_PXL.
+// Pays off along with VISIBILITY_BACKFACE, which makes the visibility flags agree with those silhouettes.
+//#define  TERMINATOR_SECANT
+
+// Uncommenting the next line will keep, for the first VISIBILITY_CACHE_PHASES OSCILLATOR_ANCHORED phases, each grid vertex's
+// ILLUMINATION_SPOTLIGHT visibility and reuse it when the phase comes round again, instead of ray marching it every frame.
+// The key is the phase alone, on purpose: with the oscillator anchored and the spotlight fixed the phase decides the surface
+// and so the outcome of every spotlight ray. Pattern, transparency & detail don't move the surface, and the cam only decides
+// which vertices get their spotlight marched at all (the others are filled in on a later visit of the phase).
+// 352 bytes of heap per phase (254 on APLITE): the whole 64 phase period is ~22K, APLITE keeps 16 phases (~4K). Halved at
+// start up until it fits the heap. No use with SHADOW_MAP.
+//#define  VISIBILITY_CACHE
+#if defined(PBL_PLATFORM_APLITE)
+  #define  VISIBILITY_CACHE_PHASES   16
+#else
+  #define  VISIBILITY_CACHE_PHASES   64    //  Must not exceed OSCILLATOR_PHASE_PERIOD.
+#endif
+
+
 /* -----------   PHYSICS PARAMETERS   ----------- */
 
 //  With a lubrication value of 6 drag is 1/2^6 (1/64 ~1.5%) of speed. Should kill all speed in about 100 frames (~4s)
@@ -86,9 +141,48 @@
 //  Decrease this value for a "lighter" feeling
 #define OSCILLATOR_INERTIA_LEVEL        1
 
+//  Uncommenting the next line will hold the OSCILLATOR_ANCHORED cam viewpoint still while the averaged accelerometer changes by
+//  less than this (in mG): filters sensor noise out of the view. Looks only, no speed: the cam rotates every frame anyway.
+//  Increase this value for a steadier view
+//  Decrease this value for a more responsive one
+//#define CAM_VIEWPOINT_DEADBAND          8
+
 //  Controls how fast the oscillator cycles.
 //  Increase this value for a "faster" wave
 //  Decrease this value for a "slower" wave
 #define OSCILLATOR_PHASE_SPEED        10
 
+//  Commenting the next line will use Q_sqrt( ) for the per frame FLOATING/BOUNCING vertex distances,
+//  instead of interpolating a square root table built once at grid_initialize( ).
+#define DIST_TABLE
+
+//  Commenting the next line will evaluate every vertex, instead of a single octant, when the oscillator sits at the
+//  center of the (symmetric) grid: dist2osc & z are then symmetric over x, y and the diagonal.
+//  Saves compute only, not RAM: the full tables stay (FLOATING/BOUNCING and the draw passes read them), and the octant
+//  distances come on top of them: 392 bytes (288 on APLITE), plus up to 105 bytes (78) of stack while z is mirrored.
+#define OCTANT_SYMMETRY
+
+//  Commenting the next line will evaluate z := f( distance ) with one cos_lookup( ) per call,
+//  instead of interpolating a radial wave profile table built once per frame.
+#define RADIAL_LUT
+
+//  Commenting the next line will recompute every OSCILLATOR_ANCHORED z value every frame, instead of caching them per phase:
+//  with the oscillator anchored the z tables repeat every 2^16 >> OSCILLATOR_PHASE_SPEED frames.
+//  Not on APLITE: the cache takes ~11.5K of heap (181 distance classes x 64 phases).
+#if !defined(PBL_PLATFORM_APLITE)
+  #define ANCHORED_CACHE
+#endif
+
+//  EXPERIMENTAL. Uncommenting the next line will project the grid a row at a time through a per camera 3x4 matrix and a
+//  reciprocal table, instead of a screen_project( ) (CamQ3_view( ) & co.) per vertex. Not bit exact (a fraction of the vertices
+//  land 1 pixel off screen_project( )'s), so keep it off by default: BENCHMARK logs the vertices that differ.
+//  It reads karambola's CamQ3 fields (viewPoint, xAxis, yAxis, zAxis, zoom) and redoes CamQ3_view( )'s math itself: that has
+//  only been checked against host/'s CamQ3 stand-in, not the real karambola. Run BENCHMARK on a watch build before trusting it.
+//#define SCREEN_PROJECT_BATCH
+
+//  Uncommenting the next line will have grid_draw( ) write its dots straight into the captured framebuffer (8 bit, 8 bit round
+//  or 1 bit), instead of a graphics_context_set_stroke_color( ) + graphics_draw_pixel( ) call each. Lines still draw through
+//  the GContext.
+//#define FRAMEBUFFER_DRAW
+
 
@@ -60,12 +60,44 @@ typedef enum { DETAIL_UNDEFINED
 Detail ;
 
 
+typedef enum { PROFILE_STAGE_OSCILLATOR
+             , PROFILE_STAGE_Z
+             , PROFILE_STAGE_CAMERA
+             , PROFILE_STAGE_VISIBILITY
+             , PROFILE_STAGE_PROJECT
+             , PROFILE_STAGE_DRAW
+             , PROFILE_STAGES
+             }
+ProfileStage ;
+
+
+typedef enum { PROFILE_COUNTER_RAYS
+             , PROFILE_COUNTER_PROBES
+             , PROFILE_COUNTER_SUBDIVISIONS
+             , PROFILE_COUNTER_HINT_TRIES
+             , PROFILE_COUNTER_HINT_HITS
+             , PROFILE_COUNTER_OCCLUDER_HITS
+             , PROFILE_COUNTER_BACKFACES
+             , PROFILE_COUNTER_MARGINS
+             , PROFILE_COUNTER_DRAW_DEPTH
+             , PROFILE_COUNTER_CAM_HOLDS
+             , PROFILE_COUNTER_VIS_CACHE_HITS
+             , PROFILE_COUNTER_VIS_CACHE_MISSES
+             , PROFILE_COUNTERS
+             }
+ProfileCounter ;
+
+
 /* -----------   STRUCTS   ----------- */
 
 typedef struct
 {
   bool cam      :1 ;
   bool spotlight:1 ;
+#if defined(VISIBILITY_HINTS)
+  uint8_t camHint      :6 ;    // Ray k (in 1/64) where last frame's cam ray crossed the surface, 0 if it didn't.
+  uint8_t spotlightHint:6 ;    // Same for the spotlight ray.
+#endif
 } Visibility ;
 
 
@@ -80,6 +112,13 @@ typedef struct
 } Boxing ;
 
 
+typedef struct
+{
+  Q     x, y ;    // Where a view ray last crossed the surface.
+  bool  isSet ;
+} Occluder ;
+
+
 union Pen
 {
   GColor  color ;
@@ -94,4 +133,8 @@ typedef struct
   Visibility  visibility ;
   GPoint      screen ;
   union Pen   pen ;
+#if defined(TERMINATOR_SECANT)
+  Q           camMargin ;         // Near field occlusion margins (function_facing), 0 until evaluated.
+  Q           spotlightMargin ;
+#endif
 } Fuxel ;
\ No newline at end of file